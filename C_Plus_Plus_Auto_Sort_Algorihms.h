@@ -0,0 +1,401 @@
+#ifndef _C_PLUS_PLUS_AUTO_SORT_ALGORIHMS_
+#define _C_PLUS_PLUS_AUTO_SORT_ALGORIHMS_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "C_Plus_Plus_Data_Structure_Algorihms.h"
+#include "C_Plus_Plus_Benchmark_Algorihms.h"
+
+// ----------------------------------------------------------------- Auto Sort -----------------------------------------------------------------
+// Xem nhanh dữ liệu trước khi sắp xếp rồi chọn thuật toán thay vì chọn tay trong main():
+//  - đếm số run (tăng hoặc giảm chặt) bằng một lượt duyệt, dừng sớm khi đã biết là quá nhiều run
+//  - ước lượng số nghịch thế, tỉ lệ khóa trùng và độ rộng khóa trên một mẫu ngẫu nhiên cỡ samples phần tử
+// rồi chọn: không làm gì (đã sắp xếp), insertion sort (mảng nhỏ hoặc gần như đã sắp xếp), merge sort theo run
+// (dữ liệu gồm ít run dài), radix sort (khóa số ít trùng) hoặc introsort cho các trường hợp còn lại.
+// Quyết định của lần sort() gần nhất được giữ trong decision(). AutoSort không ổn định.
+
+enum class AutoAlgorithm {
+    None,       // đã sắp xếp sẵn
+    Insertion,
+    Merge,
+    Radix,
+    Intro
+};
+
+inline const char* autoAlgorithmName(AutoAlgorithm algorithm) {
+    switch (algorithm) {
+    case AutoAlgorithm::None:      return "none";
+    case AutoAlgorithm::Insertion: return "insertion";
+    case AutoAlgorithm::Merge:     return "merge";
+    case AutoAlgorithm::Radix:     return "radix";
+    case AutoAlgorithm::Intro:     return "intro";
+    }
+    return "unknown";
+}
+
+// Các ngưỡng chọn thuật toán. Giá trị mặc định lấy từ SortBenchmark trên x86-64 (L2 2 MB),
+// có thể đo lại trên máy đích rồi dùng tuneAutoSort() để tính lại.
+struct AutoSortConfig {
+    size_t insertionMaxSize = 16;              // mảng không lớn hơn thế này luôn dùng insertion sort
+    double insertionMaxInversions = 2.0;       // số nghịch thế trung bình mỗi phần tử tối đa để dùng insertion sort
+    size_t runMergeLength = 64;                // độ dài run trung bình tối thiểu để dùng merge sort
+    size_t radixMinSize = 4096;
+    size_t radixMaxPasses = 4;                 // radix luôn có lợi khi khóa chỉ khác nhau ở tối đa chừng này byte
+    size_t radixMaxSize = size_t(1) << 19;     // khóa rộng hơn radixMaxPasses byte: chỉ dùng radix tới kích thước này
+    double radixMaxDuplicates = 0.5;           // nhiều khóa trùng hơn thì introsort (phân hoạch 3 nhánh) nhanh hơn
+    size_t samples = 256;                      // số phần tử / số cặp được lấy mẫu
+};
+
+// Những gì AutoSort đo được trên dữ liệu
+struct AutoSortProfile {
+    size_t size = 0;
+    size_t runs = 0;            // số run tăng / giảm chặt
+    bool runsExact = false;     // false: lượt đếm dừng sớm, runs chỉ là chặn dưới
+    // Các giá trị lấy mẫu chỉ được đo khi chúng có thể đổi quyết định (-1 / 0: không đo):
+    // nghịch thế khi insertion sort còn có thể được chọn, khóa khi radix sort còn có thể được chọn
+    double inversions = -1;     // số nghịch thế ước lượng từ các cặp ngẫu nhiên
+    double duplicates = -1;     // tỉ lệ cặp liền kề bằng nhau trong mẫu đã sắp xếp
+    unsigned keyBits = 0;       // độ rộng (bit) của phần khóa radix thay đổi trong mẫu
+    unsigned radixPasses = 0;   // số byte khóa thay đổi trong mẫu = số lượt RadixSort ước lượng
+};
+
+struct AutoSortDecision {
+    AutoSortProfile profile;
+    AutoAlgorithm algorithm = AutoAlgorithm::None;
+    std::string reason;
+
+    std::string toJson() const {
+        std::ostringstream out;
+        auto estimate = [&](const char* name, double value) {
+            out << ", \"" << name << "\": ";
+            if (value >= 0)
+                out << value;
+            else
+                out << "null";
+        };
+        out << "{\"algorithm\": \"" << autoAlgorithmName(algorithm) << "\", \"reason\": \"" << reason
+            << "\", \"size\": " << profile.size << ", \"runs\": " << profile.runs
+            << ", \"runs_exact\": " << (profile.runsExact ? "true" : "false");
+        estimate("inversions", profile.inversions);
+        estimate("duplicates", profile.duplicates);
+        out << ", \"key_bits\": " << profile.keyBits << ", \"radix_passes\": " << profile.radixPasses << "}";
+        return out.str();
+    }
+};
+
+namespace auto_sort_detail {
+
+// SplitMix64: đủ tốt để chọn vị trí lấy mẫu, cố định seed nên quyết định tái lập được với cùng dữ liệu
+inline uint64_t mix(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Số ngẫu nhiên trong [0, n): nhân rồi lấy phần cao thay cho phép chia (đắt hơn nhiều so với một lần so sánh)
+inline size_t below(uint64_t& state, size_t n) {
+    const uint64_t x = mix(state);
+    if (n <= std::numeric_limits<uint32_t>::max())
+        return static_cast<size_t>(((x >> 32) * n) >> 32);
+    return static_cast<size_t>(x % n);
+}
+
+// Đếm run kiểu TimSort: run giảm chặt hoặc không giảm. Dừng khi số run vượt limit;
+// second = true nghĩa là đã duyệt hết mảng
+template <typename T, typename Cmp>
+std::pair<size_t, bool> countRuns(const T* d, size_t n, size_t limit, Cmp comp) {
+    size_t runs = 0;
+    size_t start = 0;
+    while (start < n && runs <= limit) {
+        size_t end = start + 1;
+        if (end < n && comp(d[end], d[start])) {
+            while (end + 1 < n && comp(d[end + 1], d[end])) ++end;
+        } else {
+            while (end + 1 < n && !comp(d[end + 1], d[end])) ++end;
+        }
+        ++runs;
+        start = end + 1;
+    }
+    return {runs, start >= n};
+}
+
+template <typename T>
+constexpr bool radixKey = std::is_arithmetic<T>::value && !std::is_same<T, bool>::value && sizeof(T) <= 8;
+
+} // namespace auto_sort_detail
+
+template <typename T, typename Compare = DirectionOrder<T>>
+class AutoSort : public BasicSort<T, Compare> {
+public:
+    AutoSort(T* arr, size_t sz, Compare cmp = Compare(), AutoSortConfig config = AutoSortConfig())
+        : BasicSort<T, Compare>(arr, sz, cmp), settings(config) {}
+
+    AutoSort(std::vector<T>& vec, Compare cmp = Compare(), AutoSortConfig config = AutoSortConfig())
+        : BasicSort<T, Compare>(vec, cmp), settings(config) {}
+
+    void sort() override {
+        latest = plan();
+        this->withComparator([&](auto comp) { run(latest, comp); });
+    }
+
+    // Đo dữ liệu và chọn thuật toán nhưng không sắp xếp
+    AutoSortDecision plan() const {
+        AutoSortDecision result;
+        this->withComparator([&](auto comp) { result = decide(comp); });
+        return result;
+    }
+
+    // Quyết định của lần sort() gần nhất
+    const AutoSortDecision& decision() const { return latest; }
+
+    const AutoSortConfig& config() const { return settings; }
+    void setConfig(const AutoSortConfig& config) { settings = config; }
+
+private:
+    // Radix chỉ sắp xếp theo giá trị số, nên chỉ thay được bộ so sánh theo hướng tăng / giảm mặc định
+    // (Cmp là bộ so sánh sau withComparator(): SortDirection / DirectionOrder đã thành AscendingOrder / DescendingOrder)
+    template <typename Cmp>
+    static constexpr bool radixOrder = auto_sort_detail::radixKey<T> && (std::is_same<Cmp, AscendingOrder<T>>::value ||
+                                                                         std::is_same<Cmp, DescendingOrder<T>>::value);
+
+    template <typename Cmp>
+    AutoSortDecision decide(Cmp comp) const {
+        AutoSortDecision result;
+        AutoSortProfile& profile = result.profile;
+        const size_t n = this->size;
+        const T* d = this->data;
+        profile.size = n;
+        if (n < 2) {
+            profile.runs = n;
+            profile.runsExact = true;
+            result.reason = "fewer than two elements";
+            return result;
+        }
+        if (n <= settings.insertionMaxSize) {
+            result.algorithm = AutoAlgorithm::Insertion;
+            result.reason = "size <= insertionMaxSize";
+            return result;
+        }
+
+        // Chỉ cần biết số run có vượt n / runMergeLength hay không: dữ liệu ngẫu nhiên dừng sau vài phần trăm mảng
+        const size_t runLimit = settings.runMergeLength == 0 ? 0 : n / settings.runMergeLength;
+        std::tie(profile.runs, profile.runsExact) = auto_sort_detail::countRuns(d, n, runLimit, comp);
+        if (profile.runsExact && profile.runs == 1 && !comp(d[1], d[0])) {
+            result.reason = "already sorted";
+            return result;
+        }
+        if (profile.runsExact && (profile.runs == 1 || profile.runs <= runLimit)) {
+            result.algorithm = AutoAlgorithm::Merge;
+            result.reason = profile.runs == 1 ? "single descending run" : "average run length >= runMergeLength";
+            return result;
+        }
+
+        // Chặn trên kiểu Laplace (hits + 1) / (pairs + 1): không thấy cặp ngược nào trong mẫu chưa có nghĩa là không có.
+        // Kể cả khi hits = 0 chặn trên vẫn là n(n - 1) / 2(pairs + 1), nên với n lớn insertion sort không thể được chọn
+        // và không cần lấy mẫu.
+        const size_t pairs = std::max<size_t>(settings.samples, 1);
+        if (static_cast<double>(n - 1) <= 2.0 * (pairs + 1) * settings.insertionMaxInversions) {
+            const size_t hits = sampleInversions(profile, pairs, comp);
+            const double allPairs = 0.5 * static_cast<double>(n) * static_cast<double>(n - 1);
+            if ((hits + 1.0) / (pairs + 1.0) * allPairs <= settings.insertionMaxInversions * n) {
+                result.algorithm = AutoAlgorithm::Insertion;
+                result.reason = "estimated inversions <= insertionMaxInversions * size";
+                return result;
+            }
+        }
+
+        if constexpr (radixOrder<Cmp>) {
+            if (n >= settings.radixMinSize)
+                sampleKeys(profile, std::max<size_t>(settings.samples, 2), comp);
+            if (n >= settings.radixMinSize && profile.duplicates <= settings.radixMaxDuplicates &&
+                (profile.radixPasses <= settings.radixMaxPasses || n <= settings.radixMaxSize)) {
+                result.algorithm = AutoAlgorithm::Radix;
+                result.reason = profile.radixPasses <= settings.radixMaxPasses ? "numeric keys, few radix passes"
+                                                                               : "numeric keys, size <= radixMaxSize";
+                return result;
+            }
+        }
+        result.algorithm = AutoAlgorithm::Intro;
+        result.reason = "default";
+        return result;
+    }
+
+    // Đếm số cặp (i < j) ngược thứ tự trong pairs cặp ngẫu nhiên, ghi số nghịch thế ước lượng vào profile
+    template <typename Cmp>
+    size_t sampleInversions(AutoSortProfile& profile, size_t pairs, Cmp comp) const {
+        const size_t n = this->size;
+        const T* d = this->data;
+        uint64_t state = n;
+        size_t hits = 0;
+        for (size_t k = 0; k < pairs; ++k) {
+            size_t i = auto_sort_detail::below(state, n);
+            size_t j = auto_sort_detail::below(state, n - 1);
+            if (j >= i)
+                ++j;
+            else
+                std::swap(i, j);
+            hits += comp(d[j], d[i]) ? 1 : 0;
+        }
+        profile.inversions = static_cast<double>(hits) / pairs * 0.5 * static_cast<double>(n) * static_cast<double>(n - 1);
+        return hits;
+    }
+
+    // Sắp xếp count phần tử ngẫu nhiên để ước lượng tỉ lệ khóa trùng (cặp liền kề bằng nhau) và số byte khóa radix thay đổi
+    template <typename Cmp>
+    void sampleKeys(AutoSortProfile& profile, size_t count, Cmp comp) const {
+        const size_t n = this->size;
+        const T* d = this->data;
+        uint64_t state = ~uint64_t(n);
+        std::vector<T> values(count);
+        for (T& value : values)
+            value = d[auto_sort_detail::below(state, n)];
+        sort_engine::quickSort(values.begin(), values.end(), comp);
+        size_t equal = 0;
+        for (size_t k = 1; k < count; ++k)
+            equal += comp(values[k - 1], values[k]) ? 0 : 1;
+        profile.duplicates = static_cast<double>(equal) / (count - 1);
+
+        using Key = typename RadixSort<T>::Key;
+        Key changed = 0;
+        const Key base = RadixSort<T>::toKey(values.front());
+        for (const T& value : values)
+            changed |= static_cast<Key>(RadixSort<T>::toKey(value) ^ base);
+        while (profile.keyBits < 8 * sizeof(Key) && (changed >> profile.keyBits) != 0)
+            ++profile.keyBits;
+        for (size_t byte = 0; byte < sizeof(Key); ++byte)
+            profile.radixPasses += ((changed >> (8 * byte)) & 0xFF) != 0 ? 1 : 0;
+    }
+
+    template <typename Cmp>
+    void run(const AutoSortDecision& chosen, Cmp comp) {
+        T* first = this->data;
+        T* end = this->data + this->size;
+        switch (chosen.algorithm) {
+        case AutoAlgorithm::None:
+            break;
+        case AutoAlgorithm::Insertion:
+            sort_engine::insertionSort(first, end, comp);
+            break;
+        case AutoAlgorithm::Merge:
+            // Một run giảm chặt (không có phần tử bằng nhau): chỉ cần đảo ngược, không cần quét lại tìm run
+            if (chosen.profile.runs == 1) {
+                std::reverse(first, end);
+                sort_engine::note(comp, sort_engine::SortEvent::Swap, this->size / 2);
+            } else {
+                sort_engine::mergeSort(first, end, [&] { return scratch(); }, comp);
+            }
+            break;
+        case AutoAlgorithm::Radix:
+            if constexpr (radixOrder<Cmp>) {
+                const SortDirection direction = std::is_same<Cmp, DescendingOrder<T>>::value ? SortDirection::Descending
+                                                                                              : SortDirection::Ascending;
+                RadixSort<T>(first, this->size, direction, scratch()).sort();
+            }
+            break;
+        case AutoAlgorithm::Intro:
+            sort_engine::quickSort(first, end, comp);
+            break;
+        }
+    }
+
+    T* scratch() {
+        if (owned.size() < this->size) {
+            sort_engine::note(this->comp, sort_engine::SortEvent::Scratch, (this->size - owned.size()) * sizeof(T));
+            owned.resize(this->size);
+        }
+        return owned.data();
+    }
+
+    AutoSortConfig settings;
+    AutoSortDecision latest;
+    std::pmr::vector<T> owned;
+};
+
+// Tính lại các ngưỡng từ kết quả của SortBenchmark (BenchmarkRunner::readCsv), giữ nguyên ngưỡng nào không đủ số đo.
+// Cần các dòng InsertionSort, QuickSort, RadixSort, MergeSort với phân bố uniform và sawtooth:
+//  - insertionMaxSize: kích thước lớn nhất mà InsertionSort nhanh hơn QuickSort trên uniform (mọi kiểu dữ liệu)
+//  - radixMinSize: kích thước nhỏ nhất mà RadixSort nhanh hơn QuickSort trên uniform (mọi kiểu dữ liệu)
+//  - radixMaxSize: với khóa 8 byte, kích thước lớn nhất trước lần đầu RadixSort chậm hơn QuickSort
+//  - runMergeLength: sawtooth của SortBenchmark có 16 run, lấy size / 16 nhỏ nhất mà MergeSort nhanh hơn QuickSort
+//    (không nhỏ hơn minRun: run ngắn hơn thế bị MergeSort sắp xếp lại bằng insertion sort)
+inline AutoSortConfig tuneAutoSort(const std::vector<BenchmarkResult>& results, AutoSortConfig base = AutoSortConfig()) {
+    using Case = std::tuple<std::string, std::string, size_t>;  // (kiểu, phân bố, kích thước)
+    std::map<Case, std::map<std::string, double>> medians;
+    std::set<size_t> sizes;
+    for (const BenchmarkResult& r : results) {
+        if (!r.sorted)
+            continue;
+        medians[Case(r.type, r.distribution, r.size)][r.algorithm] = r.medianMs;
+        sizes.insert(r.size);
+    }
+    auto typeBytes = [](const std::string& type) { return type == "int64" || type == "double" ? 8 : 4; };
+
+    // 1: a nhanh hơn b với mọi kiểu có đủ số đo, 0: có kiểu chậm hơn, -1: không có số đo
+    auto faster = [&](const std::string& a, const std::string& b, const std::string& distribution, size_t size,
+                      int bytes) {
+        int verdict = -1;
+        for (const auto& entry : medians) {
+            if (std::get<1>(entry.first) != distribution || std::get<2>(entry.first) != size ||
+                (bytes != 0 && typeBytes(std::get<0>(entry.first)) != bytes))
+                continue;
+            auto ta = entry.second.find(a);
+            auto tb = entry.second.find(b);
+            if (ta == entry.second.end() || tb == entry.second.end())
+                continue;
+            if (ta->second >= tb->second)
+                return 0;
+            verdict = 1;
+        }
+        return verdict;
+    };
+
+    AutoSortConfig config = base;
+    for (size_t size : sizes) {
+        int verdict = faster("InsertionSort", "QuickSort", "uniform", size, 0);
+        if (verdict == 0)
+            break;
+        if (verdict == 1)
+            config.insertionMaxSize = size;
+    }
+    for (size_t size : sizes) {
+        if (faster("RadixSort", "QuickSort", "uniform", size, 0) == 1) {
+            config.radixMinSize = size;
+            bool measured = false;
+            size_t largest = size;
+            for (auto it = sizes.find(size); it != sizes.end(); ++it) {
+                int verdict = faster("RadixSort", "QuickSort", "uniform", *it, 8);
+                if (verdict == 0)
+                    break;
+                if (verdict == 1) {
+                    measured = true;
+                    largest = *it;
+                }
+                if (std::next(it) == sizes.end() && measured)
+                    largest = std::numeric_limits<size_t>::max(); // không thua ở kích thước nào đã đo
+            }
+            if (measured)
+                config.radixMaxSize = largest;
+            break;
+        }
+    }
+    for (size_t size : sizes) {
+        if (faster("MergeSort", "QuickSort", "sawtooth", size, 0) == 1) {
+            config.runMergeLength = std::max<size_t>(size / 16, sort_engine::minRun);
+            break;
+        }
+    }
+    return config;
+}
+
+#endif
@@ -0,0 +1,200 @@
+#ifndef _C_PLUS_PLUS_BATCH_SORT_ALGORIHMS_
+#define _C_PLUS_PLUS_BATCH_SORT_ALGORIHMS_
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "C_Plus_Plus_Data_Structure_Algorihms.h"
+
+// ----------------------------------------------------------------- Batch Sort -----------------------------------------------------------------
+// Sắp xếp nhiều mảng nhỏ độc lập cùng lúc: không tạo một đối tượng QuickSort (và một lời gọi ảo) cho mỗi mảng,
+// các mảng được gom theo lớp kích thước thành các gói việc cỡ vài chục nghìn phần tử rồi chia cho thread pool.
+// Luồng gọi không bị chặn: sortAsync() trả về std::future hoặc gọi callback khi cả lô hoàn thành.
+// Dữ liệu của các mảng phải còn sống cho đến khi lô hoàn thành.
+
+// Một mảng cần sắp xếp: data[0, size)
+template <typename T>
+struct SortSpan {
+    T* data;
+    size_t size;
+};
+
+// Thuật toán được chọn theo kích thước mảng
+enum class BatchSizeClass {
+    Network,    // mạng sắp xếp SIMD (khóa số với thứ tự mặc định, mảng không lớn hơn một thanh ghi khối)
+    Insertion,  // insertion sort cho mảng rất nhỏ
+    Intro,      // introsort (phân hoạch theo khối với khóa số)
+    Merge       // merge sort ổn định (chế độ stable), vùng đệm riêng cho từng luồng
+};
+
+template <typename T, typename Compare = DirectionOrder<T>>
+class BatchSort {
+public:
+    // threads = 0 nghĩa là dùng std::thread::hardware_concurrency(); stable = true giữ thứ tự của các phần tử bằng nhau.
+    // Slot 0 của pool thuộc về luồng gọi nên pool có threads + 1 slot: đủ threads luồng nền mà luồng gọi không phải tham gia.
+    explicit BatchSort(Compare cmp = Compare(), size_t threads = 0, bool stable = false)
+        : comp(cmp), stable(stable), workers(threads == 0 ? std::max<size_t>(1, std::thread::hardware_concurrency()) : threads),
+          scratch(workers + 1), pool(workers + 1) {}
+
+    BatchSort(const BatchSort&) = delete;
+    BatchSort& operator=(const BatchSort&) = delete;
+
+    // Gọi onComplete(nullptr) khi mọi mảng đã được sắp xếp, hoặc onComplete(lỗi đầu tiên) nếu bộ so sánh ném ngoại lệ.
+    // onComplete chạy trên một luồng của pool.
+    void sortAsync(std::vector<SortSpan<T>> spans, std::function<void(std::exception_ptr)> onComplete) {
+        auto batch = std::make_shared<Batch>();
+        batch->spans = std::move(spans);
+        batch->onComplete = std::move(onComplete);
+        schedule(batch);
+    }
+
+    std::future<void> sortAsync(std::vector<SortSpan<T>> spans) {
+        auto promise = std::make_shared<std::promise<void>>();
+        std::future<void> result = promise->get_future();
+        sortAsync(std::move(spans), [promise](std::exception_ptr error) {
+            if (error)
+                promise->set_exception(error);
+            else
+                promise->set_value();
+        });
+        return result;
+    }
+
+    std::future<void> sortAsync(std::vector<std::vector<T>>& arrays) {
+        return sortAsync(spansOf(arrays));
+    }
+
+    // Phiên bản chặn: chờ cả lô hoàn thành, ném lại ngoại lệ nếu có
+    void sort(std::vector<SortSpan<T>> spans) {
+        sortAsync(std::move(spans)).get();
+    }
+
+    void sort(std::vector<std::vector<T>>& arrays) {
+        sortAsync(spansOf(arrays)).get();
+    }
+
+    // Lớp kích thước (và thuật toán) mà một mảng n phần tử sẽ dùng
+    BatchSizeClass sizeClass(size_t n) const {
+        BatchSizeClass result = BatchSizeClass::Intro;
+        sort_engine::withOrder<T>(comp, [&](auto order) { result = classify(n, order); });
+        return result;
+    }
+
+private:
+    // Số phần tử tối thiểu của một gói việc: đủ lớn để chi phí lấy việc từ pool không đáng kể
+    static constexpr size_t taskElements = size_t(1) << 15;
+
+    struct Batch {
+        std::vector<SortSpan<T>> spans;
+        std::function<void(std::exception_ptr)> onComplete;
+        std::atomic<size_t> remaining{0};
+        std::mutex errorMutex;
+        std::exception_ptr error;
+    };
+
+    static std::vector<SortSpan<T>> spansOf(std::vector<std::vector<T>>& arrays) {
+        std::vector<SortSpan<T>> spans;
+        spans.reserve(arrays.size());
+        for (std::vector<T>& array : arrays)
+            spans.push_back({array.data(), array.size()});
+        return spans;
+    }
+
+    template <typename Cmp>
+    BatchSizeClass classify(size_t n, Cmp order) const {
+        if (stable)
+            return n <= static_cast<size_t>(sort_engine::insertionThreshold) ? BatchSizeClass::Insertion : BatchSizeClass::Merge;
+        if (n <= simdSortCapacity<T>(order))
+            return BatchSizeClass::Network;
+        if (n <= static_cast<size_t>(sort_engine::insertionThreshold))
+            return BatchSizeClass::Insertion;
+        return BatchSizeClass::Intro;
+    }
+
+    // Sắp xếp các mảng theo kích thước giảm dần (các lớp kích thước nằm liền nhau, mảng lớn được nhận việc trước),
+    // rồi cắt thành các gói: mỗi gói chỉ chứa một lớp kích thước và có khoảng taskElements phần tử
+    void schedule(const std::shared_ptr<Batch>& batch) {
+        std::vector<SortSpan<T>>& spans = batch->spans;
+        std::sort(spans.begin(), spans.end(), [](const SortSpan<T>& a, const SortSpan<T>& b) { return a.size > b.size; });
+        while (!spans.empty() && spans.back().size < 2)
+            spans.pop_back();
+
+        std::vector<std::pair<size_t, size_t>> tasks;
+        for (size_t begin = 0; begin < spans.size();) {
+            const BatchSizeClass cls = sizeClass(spans[begin].size);
+            size_t end = begin;
+            size_t elements = 0;
+            while (end < spans.size() && elements < taskElements && sizeClass(spans[end].size) == cls)
+                elements += spans[end++].size;
+            tasks.emplace_back(begin, end);
+            begin = end;
+        }
+
+        if (tasks.empty()) {
+            finish(*batch);
+            return;
+        }
+        batch->remaining.store(tasks.size(), std::memory_order_relaxed);
+        for (const std::pair<size_t, size_t>& task : tasks) {
+            pool.submit([this, batch, task] {
+                try {
+                    sort_engine::withOrder<T>(comp, [&](auto order) {
+                        std::vector<T>& buffer = scratch[pool.workerIndex()];
+                        for (size_t i = task.first; i < task.second; ++i)
+                            sortOne(batch->spans[i], buffer, order);
+                    });
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(batch->errorMutex);
+                    if (!batch->error)
+                        batch->error = std::current_exception();
+                }
+                if (batch->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    finish(*batch);
+            });
+        }
+    }
+
+    static void finish(Batch& batch) {
+        if (batch.onComplete)
+            batch.onComplete(batch.error);
+    }
+
+    template <typename Cmp>
+    void sortOne(const SortSpan<T>& span, std::vector<T>& buffer, Cmp order) {
+        T* first = span.data;
+        T* last = span.data + span.size;
+        switch (classify(span.size, order)) {
+        case BatchSizeClass::Network:
+            sort_engine::smallSort(first, last, order);
+            break;
+        case BatchSizeClass::Insertion:
+            sort_engine::insertionSort(first, last, order);
+            break;
+        case BatchSizeClass::Intro:
+            sort_engine::quickSort(first, last, order);
+            break;
+        case BatchSizeClass::Merge:
+            sort_engine::mergeSort(first, last, [&] {
+                if (buffer.size() < span.size)
+                    buffer.resize(span.size);
+                return buffer.data();
+            }, order);
+            break;
+        }
+    }
+
+    Compare comp;
+    bool stable;
+    size_t workers;
+    // Vùng đệm của MergeSort cho từng slot của pool, được giữ lại giữa các mảng và các lô
+    std::vector<std::vector<T>> scratch;
+    // Khai báo cuối cùng: hủy pool trước (chạy hết các gói còn lại) khi các thành viên khác vẫn còn hợp lệ
+    WorkStealingPool pool;
+};
+
+#endif
@@ -0,0 +1,219 @@
+#include "C_Plus_Plus_Data_Structure_Algorihms.h"
+#include "C_Plus_Plus_Benchmark_Algorihms.h"
+#include "C_Plus_Plus_Random_Data_Algorihms.h"
+#include "C_Plus_Plus_Auto_Sort_Algorihms.h"
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <limits>
+
+// Chương trình benchmark: chạy mọi lớp sắp xếp trên các kích thước, kiểu dữ liệu và phân bố đầu vào,
+// in kết quả dạng CSV (mặc định) hoặc JSON ra stdout hoặc file.
+//
+// VD: ./SortBenchmark --sizes 1000,100000,10000000 --types float,int32 --dists uniform,sorted --format json --output result.json
+//     ./SortBenchmark --max-size 100000000 --algorithms QuickSort,RadixSort
+
+// Các thuật toán O(n^2) chỉ được đo tới kích thước này, nếu không một lần chạy 1e6 phần tử mất hàng giờ
+static const size_t quadraticSizeLimit = 20000;
+
+struct BenchmarkOptions {
+    std::vector<size_t> sizes{1000, 10000, 100000, 1000000, 10000000, 100000000};
+    std::vector<std::string> types{"int32", "int64", "float", "double"};
+    std::vector<std::string> distributions;  // rỗng = tất cả các phân bố của RandomGenerator
+    std::vector<std::string> algorithms;   // rỗng = tất cả
+    size_t maxSize = 10000000;             // 1e8 cần vài GB RAM nên phải bật rõ ràng bằng --max-size
+    size_t threads = 0;                    // 0 = hardware_concurrency()
+    uint64_t seed = 12345;
+    std::string format = "csv";
+    std::string output;                    // rỗng = stdout
+    BenchmarkConfig config;
+};
+
+template <typename T> struct TypeName;
+template <> struct TypeName<int32_t> { static const char* get() { return "int32"; } };
+template <> struct TypeName<int64_t> { static const char* get() { return "int64"; } };
+template <> struct TypeName<float> { static const char* get() { return "float"; } };
+template <> struct TypeName<double> { static const char* get() { return "double"; } };
+
+// Một thuật toán cần đo: tên, kích thước tối đa cho phép và hàm sắp xếp tăng dần trên mảng
+template <typename T>
+struct BenchmarkAlgorithm {
+    std::string name;
+    size_t maxSize;
+    std::function<void(T*, size_t)> sort;
+};
+
+template <typename T>
+std::vector<BenchmarkAlgorithm<T>> benchmarkAlgorithms(size_t threads) {
+    const size_t unlimited = std::numeric_limits<size_t>::max();
+    return {
+        {"SelectionSort", quadraticSizeLimit, [](T* a, size_t n) { SelectionSort<T>(a, n, SortDirection::Ascending).sort(); }},
+        {"BubbleSort", quadraticSizeLimit, [](T* a, size_t n) { BubbleSort<T>(a, n, SortDirection::Ascending).sort(); }},
+        {"InsertionSort", quadraticSizeLimit, [](T* a, size_t n) { InsertionSort<T>(a, n, SortDirection::Ascending).sort(); }},
+        {"QuickSort", unlimited, [](T* a, size_t n) { QuickSort<T>(a, n, SortDirection::Ascending).sort(); }},
+        {"ParallelQuickSort", unlimited, [threads](T* a, size_t n) { ParallelQuickSort<T>(a, n, SortDirection::Ascending, threads).sort(); }},
+        {"MergeSort", unlimited, [](T* a, size_t n) { MergeSort<T>(a, n, SortDirection::Ascending).sort(); }},
+        {"ParallelMergeSort", unlimited, [threads](T* a, size_t n) { ParallelMergeSort<T>(a, n, SortDirection::Ascending, threads).sort(); }},
+        {"RadixSort", unlimited, [](T* a, size_t n) { RadixSort<T>(a, n, SortDirection::Ascending).sort(); }},
+        {"AutoSort", unlimited, [](T* a, size_t n) { AutoSort<T>(a, n, SortDirection::Ascending).sort(); }},
+        // Mốc so sánh với thư viện chuẩn
+        {"std::sort", unlimited, [](T* a, size_t n) { std::sort(a, a + n); }},
+        {"std::stable_sort", unlimited, [](T* a, size_t n) { std::stable_sort(a, a + n); }},
+    };
+}
+
+// Sinh dữ liệu đầu vào có thể tái lập từ seed: số nguyên trải trên toàn miền giá trị, số thực trong [-1e6, 1e6]
+template <typename T>
+std::vector<T> benchmarkInput(Distribution distribution, size_t n, uint64_t seed) {
+    RandomGenerator<T> generator(seed);
+    if constexpr (std::is_integral<T>::value)
+        return generator.generateVector(distribution, n, std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+    else
+        return generator.generateVector(distribution, n, T(-1e6), T(1e6));
+}
+
+static std::vector<std::string> splitList(const std::string& text) {
+    std::vector<std::string> items;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ','))
+        if (!item.empty())
+            items.push_back(item);
+    return items;
+}
+
+static bool contains(const std::vector<std::string>& list, const std::string& value) {
+    return std::find(list.begin(), list.end(), value) != list.end();
+}
+
+static void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "  --sizes N,N,...       kich thuoc can do (mac dinh 1e3,1e4,...,1e8)\n"
+              << "  --max-size N          bo qua kich thuoc lon hon N (mac dinh 1e7)\n"
+              << "  --types LIST          int32,int64,float,double\n"
+              << "  --dists LIST          uniform,sorted,reversed,nearly_sorted,few_unique,organ_pipe,zipf,sawtooth,\n"
+              << "                        signed_zeros\n"
+              << "  --algorithms LIST     ten lop sap xep, mac dinh tat ca\n"
+              << "  --warmup N            so lan chay lam nong (mac dinh 1)\n"
+              << "  --repeats N           so lan do toi da (mac dinh 7)\n"
+              << "  --max-seconds S       gioi han thoi gian do cho moi to hop (mac dinh 3)\n"
+              << "  --threads N           so luong cho cac thuat toan song song (mac dinh hardware_concurrency)\n"
+              << "  --seed N              seed sinh du lieu (mac dinh 12345)\n"
+              << "  --format csv|json     dinh dang ket qua (mac dinh csv)\n"
+              << "  --output FILE         ghi ket qua ra file thay vi stdout\n";
+}
+
+static bool parseOptions(int argc, char** argv, BenchmarkOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string key = argv[i];
+        if (key == "--help" || key == "-h" || i + 1 >= argc)
+            return false;
+        std::string value = argv[++i];
+        if (key == "--sizes") {
+            options.sizes.clear();
+            for (const std::string& item : splitList(value))
+                options.sizes.push_back(static_cast<size_t>(std::stod(item)));  // cho phép viết 1e6
+            // Kích thước được liệt kê rõ ràng thì luôn được đo, kể cả khi lớn hơn maxSize mặc định
+            if (!options.sizes.empty())
+                options.maxSize = std::max(options.maxSize, *std::max_element(options.sizes.begin(), options.sizes.end()));
+        } else if (key == "--max-size") {
+            options.maxSize = static_cast<size_t>(std::stod(value));
+        } else if (key == "--types") {
+            options.types = splitList(value);
+        } else if (key == "--dists") {
+            options.distributions = splitList(value);
+        } else if (key == "--algorithms") {
+            options.algorithms = splitList(value);
+        } else if (key == "--warmup") {
+            options.config.warmup = std::stoul(value);
+        } else if (key == "--repeats") {
+            options.config.repeats = std::stoul(value);
+        } else if (key == "--max-seconds") {
+            options.config.maxSecondsPerCase = std::stod(value);
+        } else if (key == "--threads") {
+            options.threads = std::stoul(value);
+        } else if (key == "--seed") {
+            options.seed = std::stoull(value);
+        } else if (key == "--format") {
+            options.format = value;
+        } else if (key == "--output") {
+            options.output = value;
+        } else {
+            return false;
+        }
+    }
+    return options.format == "csv" || options.format == "json";
+}
+
+template <typename T>
+void benchmarkType(const BenchmarkOptions& options, BenchmarkRunner& runner, std::vector<BenchmarkResult>& results,
+                   std::ostream* csv) {
+    const std::vector<BenchmarkAlgorithm<T>> algorithms = benchmarkAlgorithms<T>(options.threads);
+    for (Distribution distribution : allDistributions()) {
+        const std::string distributionLabel = distributionName(distribution);
+        if (!options.distributions.empty() && !contains(options.distributions, distributionLabel))
+            continue;
+        for (size_t n : options.sizes) {
+            if (n > options.maxSize)
+                continue;
+            const std::vector<T> input = benchmarkInput<T>(distribution, n, options.seed);
+            for (const BenchmarkAlgorithm<T>& algorithm : algorithms) {
+                if (n > algorithm.maxSize || (!options.algorithms.empty() && !contains(options.algorithms, algorithm.name)))
+                    continue;
+                BenchmarkResult result = runner.run(algorithm.name, TypeName<T>::get(), distributionLabel, input, algorithm.sort);
+                if (!result.sorted)
+                    std::cerr << "WARNING: " << algorithm.name << " returned unsorted or altered output for "
+                              << TypeName<T>::get() << "/" << distributionLabel << "/" << n << std::endl;
+                // CSV được ghi ngay từng dòng để theo dõi được tiến độ khi chạy các kích thước lớn
+                if (csv) {
+                    BenchmarkRunner::writeCsvRow(*csv, result);
+                    csv->flush();
+                }
+                results.push_back(result);
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    BenchmarkOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output);
+        if (!file) {
+            std::cerr << "Cannot open " << options.output << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = options.output.empty() ? std::cout : file;
+    std::ostream* csv = options.format == "csv" ? &out : nullptr;
+    if (csv)
+        BenchmarkRunner::writeCsvHeader(*csv);
+
+    BenchmarkRunner runner(options.config);
+    std::vector<BenchmarkResult> results;
+    for (const std::string& type : options.types) {
+        if (type == "int32")
+            benchmarkType<int32_t>(options, runner, results, csv);
+        else if (type == "int64")
+            benchmarkType<int64_t>(options, runner, results, csv);
+        else if (type == "float")
+            benchmarkType<float>(options, runner, results, csv);
+        else if (type == "double")
+            benchmarkType<double>(options, runner, results, csv);
+        else
+            std::cerr << "Unknown type " << type << std::endl;
+    }
+
+    if (options.format == "json")
+        BenchmarkRunner::writeJson(out, results);
+
+    bool allSorted = std::all_of(results.begin(), results.end(), [](const BenchmarkResult& r) { return r.sorted; });
+    return allSorted ? 0 : 2;
+}
@@ -0,0 +1,189 @@
+#ifndef _C_PLUS_PLUS_BENCHMARK_ALGORIHMS_
+#define _C_PLUS_PLUS_BENCHMARK_ALGORIHMS_
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+
+// Kết quả đo của một tổ hợp (thuật toán, kiểu dữ liệu, phân bố, kích thước)
+struct BenchmarkResult {
+    std::string algorithm;
+    std::string type;
+    std::string distribution;
+    size_t size = 0;
+    size_t runs = 0;              // số lần đo thực sự (không tính warmup)
+    double medianMs = 0;
+    double p99Ms = 0;
+    double minMs = 0;
+    double elementsPerSecond = 0; // tính theo thời gian trung vị
+    bool sorted = true;           // kết quả lần chạy đầu tiên có đúng thứ tự và là hoán vị của input không
+};
+
+struct BenchmarkConfig {
+    size_t warmup = 1;              // số lần chạy bỏ qua trước khi đo (làm nóng cache, cấp phát trang, thread pool...)
+    size_t repeats = 7;             // số lần đo tối đa cho mỗi tổ hợp
+    size_t minRepeats = 3;          // số lần đo tối thiểu kể cả khi đã hết thời gian
+    double maxSecondsPerCase = 3.0; // dừng đo sớm khi tổng thời gian của một tổ hợp vượt quá giới hạn này
+};
+
+// Chạy một hàm sắp xếp nhiều lần trên cùng một bộ dữ liệu đầu vào và thống kê thời gian.
+// Mỗi lần chạy sao chép input vào vùng làm việc (không tính giờ) để mọi lần đo sắp xếp cùng một dữ liệu.
+class BenchmarkRunner {
+public:
+    explicit BenchmarkRunner(BenchmarkConfig config = BenchmarkConfig()) : config(config) {}
+
+    template <typename T, typename SortFn>
+    BenchmarkResult run(const std::string& algorithm, const std::string& type, const std::string& distribution,
+                        const std::vector<T>& input, SortFn sortFn) {
+        using Clock = std::chrono::steady_clock;
+        BenchmarkResult result;
+        result.algorithm = algorithm;
+        result.type = type;
+        result.distribution = distribution;
+        result.size = input.size();
+
+        // Đáp án để kiểm tra: chính input sắp xếp theo bit, không tính giờ
+        std::vector<T> expected(input);
+        std::sort(expected.begin(), expected.end(), bitwiseLess<T>);
+
+        std::vector<T> work(input.size());
+        for (size_t i = 0; i < config.warmup; ++i) {
+            std::copy(input.begin(), input.end(), work.begin());
+            sortFn(work.data(), work.size());
+        }
+
+        std::vector<double> samples;
+        double total = 0;
+        while (samples.size() < std::max<size_t>(config.repeats, 1)) {
+            std::copy(input.begin(), input.end(), work.begin());
+            auto start = Clock::now();
+            sortFn(work.data(), work.size());
+            std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+            if (samples.empty())
+                result.sorted = isSortedPermutation(work, expected);
+            samples.push_back(elapsed.count());
+            total += elapsed.count();
+            if (samples.size() >= config.minRepeats && total > config.maxSecondsPerCase * 1000.0)
+                break;
+        }
+
+        std::sort(samples.begin(), samples.end());
+        result.runs = samples.size();
+        result.minMs = samples.front();
+        result.medianMs = percentile(samples, 50.0);
+        result.p99Ms = percentile(samples, 99.0);
+        result.elementsPerSecond = result.medianMs > 0 ? input.size() / (result.medianMs / 1000.0) : 0;
+        return result;
+    }
+
+    // Phân vị theo nearest-rank trên mảng đã sắp xếp tăng dần
+    static double percentile(const std::vector<double>& sortedSamples, double p) {
+        if (sortedSamples.empty())
+            return 0;
+        size_t rank = static_cast<size_t>(std::ceil(p / 100.0 * sortedSamples.size()));
+        return sortedSamples[std::min(sortedSamples.size(), std::max<size_t>(rank, 1)) - 1];
+    }
+
+    static void writeCsvHeader(std::ostream& out) {
+        out << "algorithm,type,distribution,size,runs,median_ms,p99_ms,min_ms,elements_per_second,sorted\n";
+    }
+
+    static void writeCsvRow(std::ostream& out, const BenchmarkResult& r) {
+        out << r.algorithm << ',' << r.type << ',' << r.distribution << ',' << r.size << ',' << r.runs << ','
+            << r.medianMs << ',' << r.p99Ms << ',' << r.minMs << ',' << r.elementsPerSecond << ','
+            << (r.sorted ? "true" : "false") << '\n';
+    }
+
+    // Đọc lại kết quả đã ghi bằng writeCsvHeader / writeCsvRow (dòng tiêu đề và dòng sai định dạng được bỏ qua),
+    // VD để chỉnh ngưỡng của AutoSort từ một lần chạy SortBenchmark
+    static std::vector<BenchmarkResult> readCsv(std::istream& in) {
+        std::vector<BenchmarkResult> results;
+        std::string line;
+        while (std::getline(in, line)) {
+            std::vector<std::string> fields;
+            std::stringstream stream(line);
+            std::string field;
+            while (std::getline(stream, field, ','))
+                fields.push_back(field);
+            if (fields.size() != 10 || fields[0] == "algorithm")
+                continue;
+            BenchmarkResult r;
+            try {
+                r.algorithm = fields[0];
+                r.type = fields[1];
+                r.distribution = fields[2];
+                r.size = static_cast<size_t>(std::stoull(fields[3]));
+                r.runs = static_cast<size_t>(std::stoull(fields[4]));
+                r.medianMs = std::stod(fields[5]);
+                r.p99Ms = std::stod(fields[6]);
+                r.minMs = std::stod(fields[7]);
+                r.elementsPerSecond = std::stod(fields[8]);
+                r.sorted = fields[9] == "true";
+            } catch (const std::exception&) {
+                continue;
+            }
+            results.push_back(r);
+        }
+        return results;
+    }
+
+    static void writeJson(std::ostream& out, const std::vector<BenchmarkResult>& results) {
+        out << "[\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const BenchmarkResult& r = results[i];
+            out << "  {\"algorithm\": \"" << r.algorithm << "\", \"type\": \"" << r.type
+                << "\", \"distribution\": \"" << r.distribution << "\", \"size\": " << r.size
+                << ", \"runs\": " << r.runs << ", \"median_ms\": " << r.medianMs << ", \"p99_ms\": " << r.p99Ms
+                << ", \"min_ms\": " << r.minMs << ", \"elements_per_second\": " << r.elementsPerSecond
+                << ", \"sorted\": " << (r.sorted ? "true" : "false") << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        out << "]\n";
+    }
+
+private:
+    // Đúng thứ tự chưa đủ: một thuật toán ghi đè phần tử (VD hai bản +0.0 thay cho -0.0 và +0.0) vẫn cho dãy tăng dần.
+    // Sắp xếp lại output theo bit rồi so với expected (input đã sắp xếp theo bit) để kiểm tra output là hoán vị của input.
+    // work bị sắp xếp lại tại chỗ, nó được chép lại từ input trước lần chạy sau
+    template <typename T>
+    static bool isSortedPermutation(std::vector<T>& work, const std::vector<T>& expected) {
+        if (!std::is_sorted(work.begin(), work.end(), orderedLess<T>))
+            return false;
+        std::sort(work.begin(), work.end(), bitwiseLess<T>);
+        return std::equal(work.begin(), work.end(), expected.begin(), expected.end(),
+                          [](const T& a, const T& b) { return !bitwiseLess(a, b) && !bitwiseLess(b, a); });
+    }
+
+    // Thứ tự theo biểu diễn bit với kiểu số (phân biệt -0.0 / +0.0 và các NaN), theo orderedLess với kiểu khác
+    template <typename T>
+    static bool bitwiseLess(const T& a, const T& b) {
+        if constexpr (std::is_arithmetic<T>::value) {
+            return std::memcmp(&a, &b, sizeof(T)) < 0;
+        } else {
+            return orderedLess(a, b);
+        }
+    }
+
+    // So sánh tăng dần coi NaN lớn hơn mọi số, để kiểm tra kết quả không bị sai khi dữ liệu có NaN
+    template <typename T>
+    static bool orderedLess(const T& a, const T& b) {
+        if constexpr (std::is_floating_point<T>::value) {
+            if (std::isnan(a))
+                return false;
+            if (std::isnan(b))
+                return true;
+        }
+        return a < b;
+    }
+
+    BenchmarkConfig config;
+};
+
+#endif
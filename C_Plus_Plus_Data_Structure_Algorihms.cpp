@@ -16,8 +16,10 @@ int main(void)
     // std::cout << "\n";
 
     // Sử dụng RandomGenerator với array int
+    // unique_ptr tự giải phóng mảng khi ra khỏi phạm vi; truyền seed để tạo lại đúng bộ dữ liệu, VD: RandomGenerator<int> RandomArray(42);
+    // Các phân bố khác: RandomArray.generateArray(Distribution::NearlySorted, SIZE, 1, 100)
     RandomGenerator<float> RandomArray;
-    float* floatArr = RandomArray.generateRandomArray(SIZE, 1, 100);
+    std::unique_ptr<float[]> floatArr = RandomArray.generateRandomArray(SIZE, 1, 100);
     // std::cout << "Random Array (float): ";
     // for (size_t i = 0; i < SIZE; ++i) 
     // {
@@ -26,15 +28,15 @@ int main(void)
     // std::cout << "\n";
     // std::cout << "" << std::endl;
 
-    // Ghi nhận thời điểm bắt đầu
-    auto start = std::chrono::high_resolution_clock::now();    
+    // Chương trình này chỉ minh hoạ cách dùng các lớp sắp xếp. Để đo và so sánh hiệu năng hãy dùng target SortBenchmark
+    // (C_Plus_Plus_Benchmark_Algorihms.cpp), VD: ./build/SortBenchmark --sizes 1e5,1e6 --types float --format json
 
     // /* Selection_Sort */
     // std::cout << "-------------------------------------------------------------Selection_Sort-------------------------------------------------------------" << std::endl;
     // SelectionSort<float> SelectionVector(floatVec, SortDirection::Ascending);
     // SelectionVector.sort();
     // // SelectionVector.print();
-    // SelectionSort<float> SelectionArray(floatArr,SIZE, SortDirection::Ascending);
+    // SelectionSort<float> SelectionArray(floatArr.get(), SIZE, SortDirection::Ascending);
     // SelectionArray.sort();
     // // SelectionArray.print();
     // std::cout << "" << std::endl;
@@ -44,7 +46,7 @@ int main(void)
     // BubbleSort<float> BubbleSortVector(floatVec, SortDirection::Ascending);
     // BubbleSortVector.sort();
     // BubbleSortVector.print();
-    // BubbleSort<float> BubbleSortArray(floatArr,SIZE, SortDirection::Ascending);
+    // BubbleSort<float> BubbleSortArray(floatArr.get(), SIZE, SortDirection::Ascending);
     // BubbleSortArray.sort();
     // BubbleSortArray.print();
     // std::cout << "" << std::endl;
@@ -54,7 +56,7 @@ int main(void)
     // InsertionSort<float> InsertionSortVector(floatVec, SortDirection::Ascending);
     // InsertionSortVector.sort();
     // InsertionSortVector.print();
-    // InsertionSort<float> BInsertionSortArray(floatArr,SIZE, SortDirection::Ascending);
+    // InsertionSort<float> BInsertionSortArray(floatArr.get(), SIZE, SortDirection::Ascending);
     // BInsertionSortArray.sort();
     // BInsertionSortArray.print();
     // std::cout << "" << std::endl;
@@ -64,23 +66,173 @@ int main(void)
     // MergeSort<float> MergeSortVector(floatVec, SortDirection::Ascending);
     // MergeSortVector.sort();
     // // MergeSortVector.print();
-    // MergeSort<float> MergeSortArray(floatArr,SIZE, SortDirection::Ascending);
+    // MergeSort<float> MergeSortArray(floatArr.get(), SIZE, SortDirection::Ascending);
     // MergeSortArray.sort();
     // // MergeSortArray.print();
     // std::cout << "" << std::endl;
  
+    // /* Radix_Sort */
+    // std::cout << "-------------------------------------------------------------Radix_Sort-------------------------------------------------------------" << std::endl;
+    // RadixSort<float> RadixSortVector(floatVec, SortDirection::Ascending);
+    // RadixSortVector.sort();
+    // RadixSort<float> RadixSortArray(floatArr.get(), SIZE, SortDirection::Descending);
+    // RadixSortArray.sort();
+    // std::cout << "" << std::endl;
+
+    // /* Parallel_Merge_Sort */
+    // std::cout << "-------------------------------------------------------------Parallel_Merge_Sort-------------------------------------------------------------" << std::endl;
+    // ParallelMergeSort<float> ParallelMergeSortVector(floatVec, SortDirection::Ascending);
+    // ParallelMergeSortVector.sort();
+    // ParallelMergeSort<float> ParallelMergeSortArray(floatArr.get(), SIZE, SortDirection::Ascending, 8);
+    // ParallelMergeSortArray.sort();
+    // std::cout << "" << std::endl;
+
+    // /* Parallel_Quick_Sort */
+    // std::cout << "-------------------------------------------------------------Parallel_Quick_Sort-------------------------------------------------------------" << std::endl;
+    // ParallelQuickSort<float> ParallelQuickSortVector(floatVec, SortDirection::Ascending);   // số luồng mặc định = hardware_concurrency()
+    // ParallelQuickSortVector.sort();
+    // ParallelQuickSort<float> ParallelQuickSortArray(floatArr.get(), SIZE, SortDirection::Ascending, 8);
+    // ParallelQuickSortArray.sort();
+    // std::cout << "" << std::endl;
+
+    // /* External_Sort */ (cần #include "C_Plus_Plus_External_Sort_Algorihms.h")
+    // std::cout << "-------------------------------------------------------------External_Sort-------------------------------------------------------------" << std::endl;
+    // ExternalSortConfig ExternalConfig;
+    // ExternalConfig.memoryBytes = size_t(1) << 30;          // dùng tối đa 1 GB cho buffer
+    // ExternalConfig.algorithm = RunAlgorithm::Merge;        // trộn ổn định
+    // ExternalSort<float> ExternalSortFile("input.bin", "output.bin", SortDirection::Ascending, ExternalConfig);
+    // ExternalSortFile.sort();
+    // std::cout << "" << std::endl;
+
+    // /* Mapped_File_Sort */ (cần #include "C_Plus_Plus_Mapped_File_Algorihms.h")
+    // std::cout << "-------------------------------------------------------------Mapped_File_Sort-------------------------------------------------------------" << std::endl;
+    // sortMappedFile<QuickSort<float>>("input.bin", SortDirection::Ascending);   // sắp xếp tại chỗ trên file, không sao chép vào vector
+    // std::cout << "" << std::endl;
+
+    // /* Key_Value_Sort */ (cần #include "C_Plus_Plus_Key_Value_Sort_Algorihms.h")
+    // std::cout << "-------------------------------------------------------------Key_Value_Sort-------------------------------------------------------------" << std::endl;
+    // std::vector<uint32_t> order = argsort(floatVec, SortDirection::Ascending);            // floatVec[order[0]] là phần tử nhỏ nhất
+    // std::vector<int> payload(floatVec.size());                                            // dữ liệu đi kèm từng khóa
+    // KeyValueRadixSort<float, int> KeyValueVector(floatVec, payload, SortDirection::Ascending);
+    // KeyValueVector.sort();
+    // std::cout << "" << std::endl;
+
+    // /* Quick_Select */
+    // std::cout << "-------------------------------------------------------------Quick_Select-------------------------------------------------------------" << std::endl;
+    // QuickSelect<float> QuickSelectVector(floatVec, SortDirection::Descending);
+    // QuickSelectVector.partialSort(1000);                          // 1000 giá trị lớn nhất ở đầu vector, đã sắp xếp
+    // float median = QuickSelectVector.select(floatVec.size() / 2);
+    // TopK<float> TopValues(1000, SortDirection::Descending);       // top-k trên dữ liệu đến theo từng đoạn
+    // TopValues.push(floatArr.get(), SIZE);
+    // std::vector<float> best = TopValues.result();
+    // std::cout << "" << std::endl;
+
+    // /* Incremental_Sort */
+    // std::cout << "-------------------------------------------------------------Incremental_Sort-------------------------------------------------------------" << std::endl;
+    // IncrementalSort<float> IncrementalSortVector(floatVec, SortDirection::Ascending);
+    // IncrementalSortVector.sort();                                 // sắp xếp toàn bộ một lần
+    // IncrementalSortVector.append(floatArr.get(), 1000);           // chỉ sắp xếp 1000 phần tử mới rồi trộn vào
+    // floatVec.push_back(0.5f);
+    // IncrementalSortVector.update();                               // phần tử thêm trực tiếp vào vector
+    // std::cout << "" << std::endl;
+
+    // /* Instrumentation */ (cần #include "C_Plus_Plus_Instrumentation_Algorihms.h")
+    // std::cout << "-------------------------------------------------------------Instrumentation-------------------------------------------------------------" << std::endl;
+    // SortProbe Probe;
+    // QuickSort<float, CountingOrder<float>> CountedQuickSort(floatVec, Probe.order<float>(SortDirection::Ascending));
+    // std::cout << Probe.measure(CountedQuickSort).toJson() << std::endl;   // số phép so sánh, đổi chỗ, độ sâu, cycles...
+    // MergeSort<float> PlainMergeSort(floatVec, SortDirection::Ascending);
+    // std::cout << Probe.measure(PlainMergeSort).toJson() << std::endl;     // chỉ thời gian và bộ đếm phần cứng
+    // std::cout << "" << std::endl;
+
+    // /* Batch_Sort */ (cần #include "C_Plus_Plus_Batch_Sort_Algorihms.h")
+    // std::cout << "-------------------------------------------------------------Batch_Sort-------------------------------------------------------------" << std::endl;
+    // std::vector<std::vector<float>> smallArrays(1000, std::vector<float>(floatVec.begin(), floatVec.begin() + 500));
+    // BatchSort<float> Batch(SortDirection::Ascending);                      // một pool dùng lại cho mọi lô
+    // std::future<void> batchDone = Batch.sortAsync(smallArrays);            // luồng gọi không bị chặn
+    // batchDone.get();
+    // std::cout << "" << std::endl;
+
+    // /* Auto_Sort */ (cần #include "C_Plus_Plus_Auto_Sort_Algorihms.h")
+    // std::cout << "-------------------------------------------------------------Auto_Sort-------------------------------------------------------------" << std::endl;
+    // AutoSort<float> AutoSortVector(floatVec, SortDirection::Ascending);
+    // AutoSortVector.sort();                                        // tự chọn insertion / merge / radix / introsort
+    // std::cout << AutoSortVector.decision().toJson() << std::endl; // thuật toán đã chọn, lí do và các số đo trên dữ liệu
+    // std::ifstream benchmarkCsv("benchmark.csv");                  // kết quả của ./build/SortBenchmark trên máy này
+    // AutoSortConfig tuned = tuneAutoSort(BenchmarkRunner::readCsv(benchmarkCsv));
+    // AutoSort<float> TunedAutoSort(floatArr.get(), SIZE, SortDirection::Ascending, tuned);
+    // TunedAutoSort.sort();
+    // std::cout << "" << std::endl;
+
+    // /* Search_Index */ (cần #include "C_Plus_Plus_Search_Index_Algorihms.h")
+    // std::cout << "-------------------------------------------------------------Search_Index-------------------------------------------------------------" << std::endl;
+    // QuickSort<float> SortedVector(floatVec, SortDirection::Ascending);
+    // SortedVector.sort();
+    // StaticBTreeIndex<float> TreeIndex(SortedVector);                   // dựng trên kết quả đã sắp xếp, cùng thứ tự
+    // size_t rank = TreeIndex.lowerBound(50.0f);                          // = std::lower_bound(...) - floatVec.begin()
+    // size_t inRange = TreeIndex.count(10.0f, 20.0f);                     // số phần tử trong [10, 20)
+    // EytzingerIndex<float> BfsIndex(floatVec, SortDirection::Ascending);
+    // std::vector<size_t> ranks(SIZE);
+    // BfsIndex.lowerBound(floatArr.get(), SIZE, ranks.data());            // nhiều truy vấn xen kẽ nhau
+    // std::cout << "" << std::endl;
+
+    // /* String_Sort */ (cần #include "C_Plus_Plus_String_Sort_Algorihms.h")
+    // std::cout << "-------------------------------------------------------------String_Sort-------------------------------------------------------------" << std::endl;
+    // std::vector<std::string> urls = {"https://example.com/b", "https://example.com/a", "http://example.org/"};
+    // StringSort<std::string> StringSortVector(urls, SortDirection::Ascending);     // chỉ di chuyển std::string, không sao chép nội dung
+    // StringSortVector.sort();
+    // std::vector<const char*> names = {"delta", "alpha", "charlie"};
+    // StringSort<const char*> CStringSort(names, SortDirection::Descending);       // so sánh theo nội dung như strcmp
+    // CStringSort.sort();
+    // std::cout << "" << std::endl;
+
+    // /* Sort_Arena */
+    // std::cout << "-------------------------------------------------------------Sort_Arena-------------------------------------------------------------" << std::endl;
+    // SortArena arena;                                                    // giữ lại vùng đệm giữa các lần sắp xếp
+    // for (int round = 0; round < 10; ++round) {
+    //     MergeSort<float> ArenaMergeSort(floatVec, SortDirection::Ascending, &arena);
+    //     ArenaMergeSort.sort();                                          // từ lần thứ hai không cấp phát thêm
+    // }
+    // std::cout << arena.upstreamAllocations() << std::endl;
+    // std::vector<std::unique_ptr<int>> owners;                           // kiểu chỉ di chuyển được (move-only)
+    // auto byValue = [](const std::unique_ptr<int>& a, const std::unique_ptr<int>& b) { return *a < *b; };
+    // QuickSort<std::unique_ptr<int>, decltype(byValue)> OwnerSort(owners, byValue);
+    // OwnerSort.sort();
+    // std::cout << "" << std::endl;
+
+    // /* Huge_Page_Buffer */
+    // std::cout << "-------------------------------------------------------------Huge_Page_Buffer-------------------------------------------------------------" << std::endl;
+    // const size_t billions = size_t(4) << 30;                            // chỉ số 64 bit: vượt 2^31 phần tử
+    // HugePageBuffer<float> keys = RandomArray.generateHugePageArray(Distribution::Uniform, billions, 1, 100);
+    // ParallelMergeSort<float> HugeMergeSort(keys.data(), keys.size(), SortDirection::Ascending, 0,
+    //                                        hugePageResource(NumaPlacement::Interleave)); // vùng đệm rải đều các node
+    // HugeMergeSort.sort();
+    // std::cout << "" << std::endl;
+
+    // /* Lazy_Sort */ (cần #include "C_Plus_Plus_Lazy_Sort_Algorihms.h")
+    // std::cout << "-------------------------------------------------------------Lazy_Sort-------------------------------------------------------------" << std::endl;
+    // LazySort<float> LazySortVector(floatVec, SortDirection::Ascending);
+    // for (float value : LazySortVector) {                                // phần tử đầu tiên có sau O(n)
+    //     if (value > 10.0f)
+    //         break;                                                      // phần còn lại không bị sắp xếp
+    //     std::cout << value << " ";
+    // }
+    // float tenth = LazySortVector.at(9);                                 // phần tử thứ 10 theo thứ tự sắp xếp
+    // std::cout << "" << std::endl;
+
+    // /* Merge_Sorted */
+    // std::cout << "-------------------------------------------------------------Merge_Sorted-------------------------------------------------------------" << std::endl;
+    // std::vector<float> left = floatVec, right = floatVec;               // hai dãy đã sắp xếp cùng chiều
+    // std::vector<float> merged(left.size() + right.size());
+    // mergeSorted(left, right, merged.begin(), SortDirection::Ascending);  // AVX2: trộn theo khối 16 phần tử
+    // std::cout << "" << std::endl;
+
     /* Quick_Sort */
     std::cout << "-------------------------------------------------------------Quick_Sort-------------------------------------------------------------" << std::endl;
     QuickSort<float> QuickSortVector(floatVec, SortDirection::Ascending);
     QuickSortVector.sort();
-    QuickSort<float> QuickSortArray(floatArr, SIZE, SortDirection::Ascending);
+    QuickSort<float> QuickSortArray(floatArr.get(), SIZE, SortDirection::Ascending);
     QuickSortArray.sort();
 
-    // Ghi nhận thời điểm kết thúc
-    auto end = std::chrono::high_resolution_clock::now();
-    // Tính toán thời gian trôi qua
-    std::chrono::duration<double, std::milli> elapsed = end - start;
-    std::cout << "Time processing: " << elapsed.count() << "milliseconds" << std::endl;
-
     return 0;
 }
\ No newline at end of file
@@ -5,6 +5,20 @@
 #include <vector>
 #include <algorithm>
 #include <chrono> //thư viện đo thời gian thực hiện các tác vụ.
+#include <atomic>
+#include <functional>
+#include <utility>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <iterator>
+#include <memory_resource>
+#include <stdexcept>
+#include "C_Plus_Plus_Thread_Pool_Algorihms.h"
+#include "C_Plus_Plus_Sort_Arena_Algorihms.h"
+#include "C_Plus_Plus_Simd_Algorihms.h"
+#include "C_Plus_Plus_Sort_Engine_Algorihms.h"
 
 // Hướng sắp xếp
 enum class SortDirection {
@@ -12,26 +26,115 @@ enum class SortDirection {
     Descending
 };
 
-// Lớp cơ sở hỗ trợ cả mảng và vector
+// Các policy so sánh: comp(a, b) == true nghĩa là a phải đứng trước b.
+// AscendingOrder / DescendingOrder được xác định lúc biên dịch; DirectionOrder là policy mặc định, giữ SortDirection
+// lúc chạy và được các lớp sắp xếp đổi sang AscendingOrder / DescendingOrder một lần trước khi vào vòng lặp.
 template <typename T>
+using AscendingOrder = std::less<T>;
+
+template <typename T>
+using DescendingOrder = std::greater<T>;
+
+template <typename T>
+struct DirectionOrder {
+    SortDirection direction;
+
+    DirectionOrder(SortDirection dir = SortDirection::Ascending) : direction(dir) {}
+
+    bool operator()(const T& a, const T& b) const {
+        return direction == SortDirection::Ascending ? a < b : b < a;
+    }
+};
+
+// So sánh theo một trường / hàm chiếu của phần tử, ví dụ byField(&Record::price) hoặc byField(&Record::price, std::greater<>())
+template <typename Projection, typename Compare = std::less<>>
+struct ProjectionOrder {
+    Projection projection;
+    Compare compare;
+
+    ProjectionOrder(Projection proj = Projection(), Compare cmp = Compare()) : projection(proj), compare(cmp) {}
+
+    template <typename U>
+    bool operator()(const U& a, const U& b) const {
+        return compare(std::invoke(projection, a), std::invoke(projection, b));
+    }
+};
+
+template <typename Projection, typename Compare = std::less<>>
+ProjectionOrder<Projection, Compare> byField(Projection proj, Compare cmp = Compare()) {
+    return ProjectionOrder<Projection, Compare>(proj, cmp);
+}
+
+namespace sort_engine {
+
+// Đổi SortDirection / DirectionOrder sang AscendingOrder / DescendingOrder rồi gọi f, các bộ so sánh khác giữ nguyên.
+// Bộ so sánh có đo đếm (InstrumentedOrder) được đổi phần bên trong và giữ lớp đo đếm bên ngoài.
+template <typename T, typename Cmp, typename F>
+void withOrder(const Cmp& comp, F&& f) {
+    if constexpr (std::is_same<Cmp, SortDirection>::value || std::is_same<Cmp, DirectionOrder<T>>::value) {
+        if (DirectionOrder<T>(comp).direction == SortDirection::Ascending)
+            f(AscendingOrder<T>());
+        else
+            f(DescendingOrder<T>());
+    } else if constexpr (isInstrumented<Cmp>) {
+        sort_engine::withOrder<T>(comp.inner, [&](auto inner) { f(comp.rebind(inner)); });
+    } else {
+        f(comp);
+    }
+}
+
+} // namespace sort_engine
+
+// Lớp cơ sở hỗ trợ cả mảng và vector.
+// Compare là policy so sánh; với DirectionOrder mặc định, các constructor nhận trực tiếp SortDirection như trước.
+template <typename T, typename Compare = DirectionOrder<T>>
 class BasicSort {
+public:
+    using value_type = T;
+
 protected:
     T* data;
     size_t size;
     SortDirection direction;
+    Compare comp;
 
 public:
     // Constructor từ mảng
-    BasicSort(T* arr, size_t sz, SortDirection dir)
-        : data(arr), size(sz), direction(dir) {}
+    BasicSort(T* arr, size_t sz, Compare cmp = Compare())
+        : data(arr), size(sz), direction(directionOf(cmp)), comp(cmp) {}
 
     // Constructor từ vector
-    BasicSort(std::vector<T>& vec, SortDirection dir)
-        : data(vec.data()), size(vec.size()), direction(dir) {}
+    BasicSort(std::vector<T>& vec, Compare cmp = Compare())
+        : data(vec.data()), size(vec.size()), direction(directionOf(cmp)), comp(cmp) {}
 
     virtual ~BasicSort() = default;
     virtual void sort() = 0;
 
+protected:
+    static SortDirection directionOf(const Compare& cmp) {
+        if constexpr (std::is_same<Compare, DirectionOrder<T>>::value)
+            return cmp.direction;
+        else if constexpr (std::is_same<Compare, DescendingOrder<T>>::value)
+            return SortDirection::Descending;
+        else
+            return SortDirection::Ascending;
+    }
+
+    // Gọi f với bộ so sánh đã xác định lúc biên dịch: DirectionOrder được đổi sang AscendingOrder / DescendingOrder
+    // một lần ở đây, để vòng lặp trong không phải kiểm tra direction ở mỗi lần so sánh
+    template <typename F>
+    void withComparator(F&& f) const {
+        sort_engine::withOrder<T>(comp, f);
+    }
+
+public:
+    size_t length() const { return size; }
+
+    // Dữ liệu (đã sắp xếp sau sort()) và bộ so sánh, VD để dựng chỉ mục tìm kiếm trên kết quả
+    const T* begin() const { return data; }
+    const T* end() const { return data + size; }
+    const Compare& comparator() const { return comp; }
+
     void print() const {
         for (size_t i = 0; i < size; ++i) {
             std::cout << data[i] << " ";
@@ -41,146 +144,1017 @@ public:
 };
 
 // Selection Sort
-template <typename T>
-class SelectionSort : public BasicSort<T> {
+template <typename T, typename Compare = DirectionOrder<T>>
+class SelectionSort : public BasicSort<T, Compare> {
 public:
-    using BasicSort<T>::BasicSort;
+    using BasicSort<T, Compare>::BasicSort;
 
     void sort() override {
-        for (size_t i = 0; i < this->size - 1; ++i) {
-            size_t index = i;
-            for (size_t j = i + 1; j < this->size; ++j) {
-                if ((this->direction == SortDirection::Ascending && this->data[j] < this->data[index]) ||
-                    (this->direction == SortDirection::Descending && this->data[j] > this->data[index])) {
-                    index = j;
-                }
-            }
-            std::swap(this->data[i], this->data[index]);
-        }
+        this->withComparator([this](auto comp) { sort_engine::selectionSort(this->data, this->data + this->size, comp); });
     }
 };
 
 // Bubble Sort
-template <typename T>
-class BubbleSort : public BasicSort<T> {
+template <typename T, typename Compare = DirectionOrder<T>>
+class BubbleSort : public BasicSort<T, Compare> {
 public:
-    using BasicSort<T>::BasicSort;
+    using BasicSort<T, Compare>::BasicSort;
 
     void sort() override {
-        bool swapped;
-        for (size_t i = 0; i < this->size - 1; ++i) {
-            swapped = false;
-            for (size_t j = 0; j < this->size - i - 1; ++j) {
-                if ((this->direction == SortDirection::Ascending && this->data[j] > this->data[j + 1]) ||
-                    (this->direction == SortDirection::Descending && this->data[j] < this->data[j + 1])) {
-                    std::swap(this->data[j], this->data[j + 1]);
-                    swapped = true;
-                }
-            }
-            if (!swapped) break;
-        }
+        this->withComparator([this](auto comp) { sort_engine::bubbleSort(this->data, this->data + this->size, comp); });
     }
 };
 
 // Insertion Sort
-template <typename T>
-class InsertionSort : public BasicSort<T> {
+template <typename T, typename Compare = DirectionOrder<T>>
+class InsertionSort : public BasicSort<T, Compare> {
 public:
-    using BasicSort<T>::BasicSort;
+    using BasicSort<T, Compare>::BasicSort;
+
+    void sort() override {
+        this->withComparator([this](auto comp) { sort_engine::insertionSort(this->data, this->data + this->size, comp); });
+    }
+};
+
+// Quick Sort (introsort): chọn pivot median-of-3 / ninther, mạng sắp xếp SIMD hoặc insertion sort cho đoạn nhỏ.
+// Khóa số với SortDirection / AscendingOrder / DescendingOrder dùng phân hoạch theo khối không rẽ nhánh kiểu pdqsort
+// (nhận diện đoạn đã phân hoạch sẵn và đoạn nhiều khóa trùng, heapsort sau quá nhiều lần phân hoạch lệch);
+// các kiểu / bộ so sánh khác dùng phân hoạch 3 nhánh (fat partition) và chuyển sang heapsort khi độ sâu vượt 2*log2(n).
+// partition() / partition3() luôn dùng fat partition.
+template <typename T, typename Compare = DirectionOrder<T>>
+class QuickSort : public BasicSort<T, Compare> {
+public:
+    using BasicSort<T, Compare>::BasicSort;
+
+    // Chỉ số có dấu 64 bit: sắp xếp được mảng trên 2^31 phần tử, và high = low - 1 biểu diễn đoạn rỗng
+    using Index = std::ptrdiff_t;
+
+    // Trả về vị trí cuối cùng của pivot: các phần tử bên trái không đứng sau pivot, bên phải không đứng trước pivot
+    Index partition(Index low, Index high) {
+        return partition3(low, high).first;
+    }
+
+    // Fat partition: trả về [first, second] là đoạn các phần tử bằng pivot, đã nằm đúng vị trí cuối cùng
+    std::pair<Index, Index> partition3(Index low, Index high) {
+        if (low >= high)
+            return {low, high};
+        std::pair<Index, Index> result;
+        this->withComparator([&](auto comp) {
+            selectPivot(low, high, comp);
+            result = fatPartition(low, high, comp);
+        });
+        return result;
+    }
+
+    void quickSort(Index low, Index high) {
+        if (low >= high)
+            return;
+        this->withComparator([&](auto comp) { introSort(low, high, depthLimit(high - low + 1), comp); });
+    }
+
+    void sort() override {
+        if (this->size > 0)
+            quickSort(0, static_cast<Index>(this->size) - 1);
+    }
+
+protected:
+    // Các hàm bọc quanh sort_engine với chỉ số [low, high] (bao gồm cả hai đầu) như partition()/quickSort()
+    static int depthLimit(Index n) {
+        return sort_engine::depthLimit(n);
+    }
+
+    template <typename Cmp>
+    void selectPivot(Index low, Index high, Cmp comp) {
+        sort_engine::selectPivot(this->data + low, this->data + high + 1, comp);
+    }
+
+    template <typename Cmp>
+    std::pair<Index, Index> fatPartition(Index low, Index high, Cmp comp) {
+        std::pair<T*, T*> equal = sort_engine::fatPartition(this->data + low, this->data + high + 1, comp);
+        return {equal.first - this->data, equal.second - this->data - 1};
+    }
+
+    template <typename Cmp>
+    void introSort(Index low, Index high, int depth, Cmp comp) {
+        sort_engine::introSort(this->data + low, this->data + high + 1, depth, comp);
+    }
+};
+
+// Parallel Quick Sort: các phân đoạn lớn được đẩy vào work-stealing pool, phân đoạn nhỏ hơn cutoff chạy quickSort tuần tự.
+// Mặc định các luồng lấy từ sharedWorkStealingPool(threads), được giữ lại giữa các lần sort() và giữa các đối tượng.
+template <typename T, typename Compare = DirectionOrder<T>>
+class ParallelQuickSort : public QuickSort<T, Compare> {
+public:
+    using typename QuickSort<T, Compare>::Index;
+
+    // threads = 0 nghĩa là dùng std::thread::hardware_concurrency();
+    // cutoff = 0 nghĩa là tự chọn theo kích thước mảng và số luồng (khoảng tasksPerThread phân đoạn cho mỗi luồng)
+    ParallelQuickSort(T* arr, size_t sz, Compare cmp = Compare(), size_t threads = 0, size_t cutoff = 0)
+        : QuickSort<T, Compare>(arr, sz, cmp), threads(threads), cutoff(cutoff) {}
+
+    ParallelQuickSort(std::vector<T>& vec, Compare cmp = Compare(), size_t threads = 0, size_t cutoff = 0)
+        : QuickSort<T, Compare>(vec, cmp), threads(threads), cutoff(cutoff) {}
+
+    // pool: pool của người gọi, VD dùng chung với ParallelMergeSort hoặc các việc khác của chương trình
+    ParallelQuickSort(T* arr, size_t sz, Compare cmp, WorkStealingPool& pool, size_t cutoff = 0)
+        : QuickSort<T, Compare>(arr, sz, cmp), external(&pool), cutoff(cutoff) {}
+
+    ParallelQuickSort(std::vector<T>& vec, Compare cmp, WorkStealingPool& pool, size_t cutoff = 0)
+        : QuickSort<T, Compare>(vec, cmp), external(&pool), cutoff(cutoff) {}
 
     void sort() override {
-        for (size_t i = 1; i < this->size; ++i) {
-            T key = this->data[i];
-            int j = i - 1;
-            while (j >= 0 && ((this->direction == SortDirection::Ascending && this->data[j] > key) ||
-                              (this->direction == SortDirection::Descending && this->data[j] < key))) {
-                this->data[j + 1] = this->data[j];
-                --j;
+        if (this->size <= 2 * minLeaf) {
+            QuickSort<T, Compare>::sort();
+            return;
+        }
+        WorkStealingPool& pool = external ? *external : sharedWorkStealingPool(threads);
+        if (pool.size() == 1) {
+            QuickSort<T, Compare>::sort();
+            return;
+        }
+        const size_t leaf = cutoff != 0 ? std::max<size_t>(cutoff, 2)
+                                        : std::min(maxLeaf, std::max(minLeaf, this->size / (pool.size() * tasksPerThread)));
+        this->withComparator([&](auto comp) {
+            // Luồng gọi tự xử lí phân đoạn gốc; TaskGroup chỉ chờ các việc của lần sắp xếp này, kể cả khi pool dùng chung
+            WorkStealingPool::TaskGroup group(pool);
+            Index high = static_cast<Index>(this->size) - 1;
+            parallelQuickSort(group, 0, high, this->depthLimit(high + 1), leaf, comp);
+            group.wait();
+        });
+    }
+
+private:
+    // Phân đoạn tối thiểu để chia việc phân hoạch cho nhiều luồng
+    static constexpr size_t parallelPartitionGrain = 1 << 15;
+    // Cutoff tự động: mỗi luồng nhận khoảng tasksPerThread phân đoạn để cân bằng tải khi pivot lệch,
+    // nhưng phân đoạn không nhỏ hơn minLeaf (chi phí đẩy / lấy việc) và không lớn hơn maxLeaf
+    static constexpr size_t tasksPerThread = 8;
+    static constexpr size_t minLeaf = 1 << 11;
+    static constexpr size_t maxLeaf = 1 << 16;
+
+    // Đẩy một nửa vào pool cho luồng khác lấy, tự xử lí nửa còn lại cho đến khi không lớn hơn leaf
+    template <typename Cmp>
+    void parallelQuickSort(WorkStealingPool::TaskGroup& group, Index low, Index high, int depth, size_t leaf, Cmp comp) {
+        while (static_cast<size_t>(high - low + 1) > leaf) {
+            if (depth-- == 0)
+                break; // dữ liệu xấu: để introSort tuần tự lo phần còn lại (có heapsort dự phòng)
+            std::pair<Index, Index> equal = static_cast<size_t>(high - low + 1) >= 2 * parallelPartitionGrain
+                                                ? parallelPartition(group.pool(), low, high, comp)
+                                                : sequentialPartition(low, high, comp);
+            if (equal.first - low > high - equal.second) {
+                Index right = equal.first - 1;
+                group.submit([this, &group, low, right, depth, leaf, comp] {
+                    parallelQuickSort(group, low, right, depth, leaf, comp);
+                });
+                low = equal.second + 1;
+            } else {
+                Index left = equal.second + 1;
+                group.submit([this, &group, left, high, depth, leaf, comp] {
+                    parallelQuickSort(group, left, high, depth, leaf, comp);
+                });
+                high = equal.first - 1;
+            }
+        }
+        if (low < high)
+            this->introSort(low, high, this->depthLimit(high - low + 1), comp);
+    }
+
+    // Phân hoạch tuần tự như QuickSort: khóa số với thứ tự mặc định dùng phân hoạch theo khối không rẽ nhánh (nếu phần tử
+    // ngay trước đoạn bằng pivot thì gom các phần tử bằng pivot sang trái), các trường hợp khác dùng fat partition.
+    // Trả về đoạn [first, second] các phần tử bằng pivot như fatPartition()
+    template <typename Cmp>
+    std::pair<Index, Index> sequentialPartition(Index low, Index high, Cmp comp) {
+        T* d = this->data;
+        this->selectPivot(low, high, comp);
+        if constexpr (sort_engine::BlockPartitionOrder<Cmp>::value) {
+            if (low > 0 && !comp(d[low - 1], d[low]))
+                return {low, sort_engine::partitionLeft(d + low, d + high + 1, comp) - d};
+            Index pivot = sort_engine::blockPartition(d + low, d + high + 1, comp).first - d;
+            return {pivot, pivot};
+        } else {
+            return this->fatPartition(low, high, comp);
+        }
+    }
+
+    // Phân hoạch song song: trả về đoạn [first, second] các phần tử bằng pivot như fatPartition().
+    // Nếu phần tử ngay trước đoạn (pivot của cấp trên, không lớn hơn mọi phần tử trong đoạn) bằng pivot
+    // thì tách riêng các phần tử bằng pivot sang trái (kiểu pdqsort), ngược lại tách các phần tử đứng trước pivot.
+    template <typename Cmp>
+    std::pair<Index, Index> parallelPartition(WorkStealingPool& pool, Index low, Index high, Cmp comp) {
+        T* d = this->data;
+        this->selectPivot(low, high, comp);
+        const T& pivot = d[low];
+
+        if (low > 0 && !comp(d[low - 1], pivot)) {
+            Index split = parallelSplit(pool, low + 1, high, [&](const T& value) { return !comp(pivot, value); });
+            return {low, split - 1};
+        }
+        Index split = parallelSplit(pool, low + 1, high, [&](const T& value) { return comp(value, pivot); });
+        std::swap(d[low], d[split - 1]);
+        return {split - 1, split - 1};
+    }
+
+    // Phân hoạch một khối theo pred. Với kiểu số dùng Lomuto không rẽ nhánh: mỗi phần tử được đổi chỗ với vị trí k và k chỉ
+    // tăng khi phần tử thỏa pred, nên không có nhánh phụ thuộc dữ liệu (std::partition đoán sai khoảng một nửa số lần
+    // với khóa ngẫu nhiên). Các kiểu khác dùng std::partition
+    template <typename Pred>
+    static T* localPartition(T* first, T* last, Pred pred) {
+        if constexpr (std::is_arithmetic<T>::value) {
+            T* k = first;
+            for (T* it = first; it != last; ++it) {
+                const T value = *it;
+                const bool before = pred(value);
+                *it = *k;
+                *k = value;
+                k += before;
             }
-            this->data[j + 1] = key;
+            return k;
+        } else {
+            return std::partition(first, last, pred);
         }
     }
+
+    // Phân hoạch [low, high] theo pred song song, trả về vị trí phần tử đầu tiên không thỏa pred.
+    // Bước 1: mỗi khối tự phân hoạch cục bộ. Bước 2: đổi chỗ các phần tử nằm sai phía của điểm chia chung.
+    template <typename Pred>
+    Index parallelSplit(WorkStealingPool& pool, Index low, Index high, Pred pred) {
+        T* first = this->data + low;
+        const size_t n = static_cast<size_t>(high - low + 1);
+        const size_t blocks = std::max<size_t>(1, std::min(pool.size(), n / parallelPartitionGrain));
+        const size_t step = (n + blocks - 1) / blocks;
+
+        std::vector<size_t> begin(blocks + 1), leftCount(blocks);
+        for (size_t b = 0; b <= blocks; ++b)
+            begin[b] = std::min(n, b * step);
+
+        pool.parallelFor(blocks, [&](size_t b) {
+            leftCount[b] = static_cast<size_t>(localPartition(first + begin[b], first + begin[b + 1], pred) - first);
+        });
+
+        // split: số phần tử thỏa pred; các khoảng sai chỗ là [leftCount[b], begin[b+1]) ∩ [0, split)
+        // và [begin[b], leftCount[b]) ∩ [split, n), tổng độ dài hai loại luôn bằng nhau.
+        size_t split = 0;
+        for (size_t b = 0; b < blocks; ++b)
+            split += leftCount[b] - begin[b];
+
+        std::vector<std::pair<size_t, size_t>> wrongLeft, wrongRight;
+        for (size_t b = 0; b < blocks; ++b) {
+            size_t lo = leftCount[b], hi = std::min(begin[b + 1], split);
+            if (lo < hi) wrongLeft.emplace_back(lo, hi);
+            lo = std::max(begin[b], split), hi = leftCount[b];
+            if (lo < hi) wrongRight.emplace_back(lo, hi);
+        }
+
+        std::vector<size_t> prefixLeft(1, 0), prefixRight(1, 0);
+        for (auto& range : wrongLeft) prefixLeft.push_back(prefixLeft.back() + range.second - range.first);
+        for (auto& range : wrongRight) prefixRight.push_back(prefixRight.back() + range.second - range.first);
+        const size_t misplaced = prefixLeft.back();
+
+        if (misplaced > 0) {
+            const size_t swapBlocks = std::min(blocks, (misplaced + parallelPartitionGrain - 1) / parallelPartitionGrain);
+            const size_t swapStep = (misplaced + swapBlocks - 1) / swapBlocks;
+            pool.parallelFor(swapBlocks, [&](size_t b) {
+                size_t k = b * swapStep, kEnd = std::min(misplaced, k + swapStep);
+                if (k >= kEnd) return;
+                // Tìm khoảng chứa phần tử sai chỗ thứ k ở mỗi phía rồi duyệt tuần tự
+                size_t l = std::upper_bound(prefixLeft.begin(), prefixLeft.end(), k) - prefixLeft.begin() - 1;
+                size_t r = std::upper_bound(prefixRight.begin(), prefixRight.end(), k) - prefixRight.begin() - 1;
+                size_t i = wrongLeft[l].first + (k - prefixLeft[l]);
+                size_t j = wrongRight[r].first + (k - prefixRight[r]);
+                for (; k < kEnd; ++k) {
+                    if (i == wrongLeft[l].second) i = wrongLeft[++l].first;
+                    if (j == wrongRight[r].second) j = wrongRight[++r].first;
+                    std::swap(first[i++], first[j++]);
+                }
+            });
+        }
+
+        return low + static_cast<Index>(split);
+    }
+
+    size_t threads = 0;
+    WorkStealingPool* external = nullptr;
+    size_t cutoff;
 };
 
-// Quick Sort
-template <typename T>
-class QuickSort : public BasicSort<T> {
+// Quick Select: các phép chọn dựa trên cùng pivot và phân hoạch với QuickSort::partition, nhưng sau mỗi lần phân hoạch
+// chỉ đi tiếp vào phía chứa vị trí cần tìm. "Đứng đầu" hiểu theo thứ tự sắp xếp: Ascending là các phần tử nhỏ nhất,
+// Descending là các phần tử lớn nhất. sort() vẫn sắp xếp toàn bộ như QuickSort.
+template <typename T, typename Compare = DirectionOrder<T>>
+class QuickSelect : public QuickSort<T, Compare> {
 public:
-    using BasicSort<T>::BasicSort;
+    using QuickSort<T, Compare>::QuickSort;
+
+    // Đưa phần tử thứ k (tính từ 0) theo thứ tự sắp xếp về data[k]; phía trước không đứng sau nó, phía sau không đứng trước nó.
+    // Introselect: O(n) trung bình, tối đa O(n log n).
+    void nthElement(size_t k) {
+        if (k >= this->size)
+            throw std::out_of_range("QuickSelect::nthElement: k is out of range");
+        this->withComparator([&](auto comp) {
+            sort_engine::nthElement(this->data, this->data + k, this->data + this->size, comp);
+        });
+    }
+
+    // Trả về phần tử thứ k theo thứ tự sắp xếp (dữ liệu bị sắp xếp lại một phần như nthElement).
+    // Tham chiếu tới data[k] chứ không sao chép, nên dùng được với kiểu chỉ di chuyển được (move-only)
+    const T& select(size_t k) {
+        nthElement(k);
+        return this->data[k];
+    }
+
+    // k phần tử đứng đầu được đưa lên data[0..k) theo đúng thứ tự, phần còn lại không theo thứ tự. O(n + k log k)
+    void partialSort(size_t k) {
+        k = std::min(k, this->size);
+        this->withComparator([&](auto comp) {
+            sort_engine::partialSort(this->data, this->data + k, this->data + this->size, comp);
+        });
+    }
+};
+
+// Top-k dạng luồng: nhận dữ liệu theo từng đoạn (chunk) và chỉ giữ k phần tử đứng đầu đã thấy, không cần toàn bộ dữ liệu
+// trong bộ nhớ. Bộ đệm chứa tối đa 2k phần tử; khi đầy, nthElement giữ lại k phần tử tốt nhất và phần tử thứ k trở thành
+// ngưỡng để loại ngay các phần tử không thể lọt vào top-k. Tổng chi phí O(n) trung bình.
+// VD: TopK<float> top(1000, SortDirection::Descending) giữ 1000 giá trị lớn nhất.
+template <typename T, typename Compare = DirectionOrder<T>>
+class TopK {
+public:
+    explicit TopK(size_t k, Compare cmp = Compare()) : k(k), comp(cmp) {
+        buffer.reserve(2 * k);
+    }
+
+    // Phần tử của chunk được sao chép vào bộ đệm; các overload nhận rvalue di chuyển chúng vào
+    void push(const T* chunk, size_t count) {
+        pushRange(chunk, count);
+    }
+
+    void push(const std::vector<T>& chunk) { push(chunk.data(), chunk.size()); }
+    void push(std::vector<T>&& chunk) { pushRange(std::make_move_iterator(chunk.data()), chunk.size()); }
+    void push(const T& value) { push(&value, 1); }
+    void push(T&& value) { pushRange(std::make_move_iterator(&value), 1); }
+
+    // k phần tử đứng đầu đã thấy (ít hơn nếu chưa nhận đủ k phần tử), theo đúng thứ tự sắp xếp
+    std::vector<T> result() const& {
+        std::vector<T> best(buffer);
+        finish(best);
+        return best;
+    }
+
+    // Như trên nhưng lấy luôn bộ đệm, không sao chép: VD std::move(top).result()
+    std::vector<T> result() && {
+        std::vector<T> best(std::move(buffer));
+        finish(best);
+        clear();
+        return best;
+    }
+
+    void clear() {
+        buffer.clear();
+        hasThreshold = false;
+    }
 
-    int partition(int low, int high) {
-        T pivot = this->data[high];
-        int i = low - 1;
+private:
+    template <typename It>
+    void pushRange(It chunk, size_t count) {
+        if (k == 0)
+            return;
+        sort_engine::withOrder<T>(comp, [&](auto order) {
+            for (size_t i = 0; i < count; ++i, ++chunk) {
+                if (hasThreshold && !order(*chunk, buffer[k - 1]))
+                    continue;
+                buffer.push_back(*chunk);
+                if (buffer.size() == 2 * k)
+                    shrink(order);
+            }
+        });
+    }
+
+    void finish(std::vector<T>& best) const {
+        sort_engine::withOrder<T>(comp, [&](auto order) {
+            const size_t kept = std::min(k, best.size());
+            sort_engine::partialSort(best.data(), best.data() + kept, best.data() + best.size(), order);
+            best.erase(best.begin() + kept, best.end());
+        });
+    }
+
+    // Sau khi thu gọn, phần tử thứ k nằm ở buffer[k - 1] và là ngưỡng cho các phần tử tiếp theo;
+    // các phần tử mới chỉ được thêm vào sau nó nên ngưỡng không bị sao chép ra biến riêng
+    template <typename Cmp>
+    void shrink(Cmp order) {
+        sort_engine::nthElement(buffer.data(), buffer.data() + (k - 1), buffer.data() + buffer.size(), order);
+        buffer.erase(buffer.begin() + k, buffer.end());
+        hasThreshold = true;
+    }
+
+    size_t k;
+    Compare comp;
+    std::vector<T> buffer;
+    bool hasThreshold = false;
+};
+
+// Merge Sort: bottom-up kiểu TimSort. Các run tăng/giảm sẵn có được nhận diện (run giảm chặt được đảo ngược),
+// run ngắn được kéo dài tới minRun bằng insertion sort, sau đó trộn từng cặp run qua lại giữa data và một
+// vùng đệm duy nhất (ping-pong), không cấp phát bộ nhớ trong lúc trộn.
+// Phần tử chỉ được di chuyển, không bị sao chép (dùng được với kiểu move-only); vùng đệm tự cấp cần T có constructor mặc định.
+template <typename T, typename Compare = DirectionOrder<T>>
+class MergeSort : public BasicSort<T, Compare> {
+public:
+    using BasicSort<T, Compare>::BasicSort;
+
+    // scratch: vùng đệm do người gọi cấp, tối thiểu sz phần tử; nullptr thì MergeSort tự cấp phát một lần
+    MergeSort(T* arr, size_t sz, Compare cmp, T* scratch)
+        : BasicSort<T, Compare>(arr, sz, cmp), external(scratch) {}
+
+    MergeSort(std::vector<T>& vec, Compare cmp, T* scratch)
+        : BasicSort<T, Compare>(vec, cmp), external(scratch) {}
+
+    // allocator: nguồn cấp phát vùng đệm, VD &arena với một SortArena dùng chung cho nhiều lần sắp xếp
+    MergeSort(T* arr, size_t sz, Compare cmp, std::pmr::polymorphic_allocator<T> allocator)
+        : BasicSort<T, Compare>(arr, sz, cmp), owned(allocator) {}
+
+    MergeSort(std::vector<T>& vec, Compare cmp, std::pmr::polymorphic_allocator<T> allocator)
+        : BasicSort<T, Compare>(vec, cmp), owned(allocator) {}
+
+    // Trộn hai đoạn đã sắp xếp data[left..mid] và data[mid+1..right]
+    void merge(std::ptrdiff_t left, std::ptrdiff_t mid, std::ptrdiff_t right) {
+        if (left > mid || mid >= right)
+            return;
+        T* buffer = scratch();
+        this->withComparator([&](auto comp) {
+            if (!comp(this->data[mid + 1], this->data[mid]))
+                return;
+            std::move(this->data + left, this->data + mid + 1, buffer + left);
+            sort_engine::mergeStable(buffer + left, buffer + mid + 1, this->data + mid + 1, this->data + right + 1,
+                                     this->data + left, comp);
+        });
+    }
+
+    void sort() override {
+        if (this->size < 2)
+            return;
+        this->withComparator([&](auto comp) { sortRange(0, this->size, comp); });
+    }
+
+protected:
+    T* scratch() {
+        if (external != nullptr)
+            return external;
+        // Cấp phát đúng một lần cho cả lần sort, trước khi các luồng dùng chung vùng đệm
+        if (owned.size() < this->size) {
+            sort_engine::note(this->comp, sort_engine::SortEvent::Scratch, (this->size - owned.size()) * sizeof(T));
+            owned.resize(this->size);
+        }
+        return owned.data();
+    }
+
+    std::pmr::memory_resource* resource() const { return owned.get_allocator().resource(); }
+
+    // Sắp xếp ổn định data[first, last), dùng vùng đệm scratch() ở cùng vị trí nên các đoạn rời nhau
+    // có thể được sắp xếp đồng thời
+    template <typename Cmp>
+    void sortRange(size_t first, size_t last, Cmp comp) {
+        sort_engine::mergeSort(this->data + first, this->data + last, [&] { return scratch() + first; }, comp, resource());
+    }
+
+    T* external = nullptr;
+    std::pmr::vector<T> owned;
+};
+
+// Parallel Merge Sort: mỗi luồng sắp xếp ổn định một khối, sau đó các cặp khối được trộn qua lại giữa data và
+// vùng đệm; mỗi lần trộn được chia thành nhiều đoạn đầu ra độc lập bằng merge path (co-rank) để nhiều luồng
+// cùng trộn. Kết quả giống hệt MergeSort tuần tự vì cả hai đều ổn định.
+// Như ParallelQuickSort, mặc định dùng sharedWorkStealingPool(threads) hoặc một pool được truyền vào constructor.
+template <typename T, typename Compare = DirectionOrder<T>>
+class ParallelMergeSort : public MergeSort<T, Compare> {
+public:
+    // threads = 0 nghĩa là dùng std::thread::hardware_concurrency()
+    ParallelMergeSort(T* arr, size_t sz, Compare cmp = Compare(), size_t threads = 0, T* scratch = nullptr)
+        : MergeSort<T, Compare>(arr, sz, cmp, scratch), threads(threads) {}
+
+    ParallelMergeSort(std::vector<T>& vec, Compare cmp = Compare(), size_t threads = 0, T* scratch = nullptr)
+        : MergeSort<T, Compare>(vec, cmp, scratch), threads(threads) {}
+
+    ParallelMergeSort(T* arr, size_t sz, Compare cmp, size_t threads, std::pmr::polymorphic_allocator<T> allocator)
+        : MergeSort<T, Compare>(arr, sz, cmp, allocator), threads(threads) {}
 
-        for (int j = low; j < high; ++j) {
-            if ((this->direction == SortDirection::Ascending && this->data[j] <= pivot) ||
-                (this->direction == SortDirection::Descending && this->data[j] >= pivot)) {
-                ++i;
-                std::swap(this->data[i], this->data[j]);
+    ParallelMergeSort(std::vector<T>& vec, Compare cmp, size_t threads, std::pmr::polymorphic_allocator<T> allocator)
+        : MergeSort<T, Compare>(vec, cmp, allocator), threads(threads) {}
+
+    // pool: pool của người gọi, dùng chung với các thuật toán / việc khác
+    ParallelMergeSort(T* arr, size_t sz, Compare cmp, WorkStealingPool& pool, T* scratch = nullptr)
+        : MergeSort<T, Compare>(arr, sz, cmp, scratch), external(&pool) {}
+
+    ParallelMergeSort(std::vector<T>& vec, Compare cmp, WorkStealingPool& pool, T* scratch = nullptr)
+        : MergeSort<T, Compare>(vec, cmp, scratch), external(&pool) {}
+
+    ParallelMergeSort(T* arr, size_t sz, Compare cmp, WorkStealingPool& pool, std::pmr::polymorphic_allocator<T> allocator)
+        : MergeSort<T, Compare>(arr, sz, cmp, allocator), external(&pool) {}
+
+    ParallelMergeSort(std::vector<T>& vec, Compare cmp, WorkStealingPool& pool, std::pmr::polymorphic_allocator<T> allocator)
+        : MergeSort<T, Compare>(vec, cmp, allocator), external(&pool) {}
+
+    void sort() override {
+        if (this->size < 2 * grain) {
+            MergeSort<T, Compare>::sort();
+            return;
+        }
+        WorkStealingPool& pool = external ? *external : sharedWorkStealingPool(threads);
+        const size_t chunks = std::min(pool.size(), this->size / grain);
+        if (chunks < 2) {
+            MergeSort<T, Compare>::sort();
+            return;
+        }
+        this->withComparator([&](auto comp) { parallelSort(pool, chunks, comp); });
+    }
+
+private:
+    // Số phần tử tối thiểu cho một khối hoặc một đoạn trộn được giao cho một luồng
+    static constexpr size_t grain = 1 << 14;
+
+    // Một đoạn đầu ra [outFirst, outLast) của phép trộn hai run [a, mid) và [mid, b)
+    struct MergeSegment {
+        size_t a, mid, b;
+        size_t outFirst, outLast;
+    };
+
+    template <typename Cmp>
+    void parallelSort(WorkStealingPool& pool, size_t chunks, Cmp comp) {
+        const size_t n = this->size;
+        T* buffer = this->scratch();
+
+        std::pmr::vector<size_t> runs(chunks + 1, this->resource());
+        for (size_t c = 0; c <= chunks; ++c)
+            runs[c] = n / chunks * c + std::min(c, n % chunks);
+        pool.parallelFor(chunks, [&](size_t c) { this->sortRange(runs[c], runs[c + 1], comp); });
+
+        const size_t segmentLength = std::max(grain, (n + pool.size() - 1) / pool.size());
+        T* src = this->data;
+        T* dst = buffer;
+        std::pmr::vector<MergeSegment> segments(this->resource());
+        while (runs.size() > 2) {
+            segments.clear();
+            size_t count = 0;
+            for (size_t k = 0; k + 1 < runs.size(); k += 2) {
+                // Run lẻ cuối cùng được xem như trộn với một run rỗng
+                size_t a = runs[k], mid = runs[k + 1], b = k + 2 < runs.size() ? runs[k + 2] : mid;
+                for (size_t out = a; out < b; out += segmentLength)
+                    segments.push_back({a, mid, b, out, std::min(b, out + segmentLength)});
+                runs[count++] = a;
             }
+            runs[count++] = n;
+            runs.resize(count);
+
+            pool.parallelFor(segments.size(), [&](size_t s) {
+                const MergeSegment& seg = segments[s];
+                const T* left = src + seg.a;
+                const T* right = src + seg.mid;
+                size_t leftLength = seg.mid - seg.a, rightLength = seg.b - seg.mid;
+                size_t i0 = coRank(seg.outFirst - seg.a, left, leftLength, right, rightLength, comp);
+                size_t i1 = coRank(seg.outLast - seg.a, left, leftLength, right, rightLength, comp);
+                size_t j0 = seg.outFirst - seg.a - i0, j1 = seg.outLast - seg.a - i1;
+                sort_engine::mergeStable(src + seg.a + i0, src + seg.a + i1, src + seg.mid + j0, src + seg.mid + j1,
+                                         dst + seg.outFirst, comp);
+            });
+            std::swap(src, dst);
+        }
+
+        if (src != this->data) {
+            const size_t blocks = (n + segmentLength - 1) / segmentLength;
+            pool.parallelFor(blocks, [&](size_t b) {
+                size_t first = b * segmentLength, last = std::min(n, first + segmentLength);
+                std::move(src + first, src + last, this->data + first);
+            });
         }
-        std::swap(this->data[i + 1], this->data[high]);
-        return i + 1;
     }
 
-    void quickSort(int low, int high) {
-        if (low < high) {
-            int pi = partition(low, high);
-            quickSort(low, pi - 1);
-            quickSort(pi + 1, high);
+    // Số phần tử của run trái nằm trong k phần tử đầu tiên của phép trộn ổn định (tìm nhị phân trên merge path)
+    template <typename Cmp>
+    static size_t coRank(size_t k, const T* left, size_t leftLength, const T* right, size_t rightLength, Cmp comp) {
+        size_t lo = k > rightLength ? k - rightLength : 0;
+        size_t hi = std::min(k, leftLength);
+        while (lo < hi) {
+            size_t i = lo + (hi - lo) / 2;
+            // left[i] không đứng sau right[k - i - 1] (ưu tiên run trái khi bằng nhau) thì cần lấy thêm từ run trái
+            if (!comp(right[k - i - 1], left[i]))
+                lo = i + 1;
+            else
+                hi = i;
         }
+        return lo;
     }
 
+    size_t threads = 0;
+    WorkStealingPool* external = nullptr;
+};
+
+// Incremental Sort: vector có đoạn đầu [0, sortedSize()) đã được sắp xếp, phần tử mới được thêm vào cuối theo từng đợt.
+// update() chỉ sắp xếp phần đuôi mới rồi trộn vào đoạn đầu: hai đầu đoạn trộn được cắt bỏ bằng tìm kiếm nhị phân,
+// đợt nhỏ hơn nhiều so với đoạn đầu được chèn bằng galloping (mỗi khối phần tử cũ chỉ bị dời một lần),
+// vùng đệm trộn không vượt quá bufferLimit phần tử (vượt quá thì trộn bằng rotate).
+// Phần tử cũ luôn đứng trước phần tử mới bằng nó; thứ tự giữa các phần tử mới bằng nhau không được giữ.
+template <typename T, typename Compare = DirectionOrder<T>>
+class IncrementalSort : public BasicSort<T, Compare> {
+public:
+    // sortedPrefix: số phần tử đầu của vec đã được sắp xếp sẵn; allocator: nguồn cấp phát vùng đệm trộn
+    IncrementalSort(std::vector<T>& vec, Compare cmp = Compare(), size_t sortedPrefix = 0,
+                    size_t bufferLimit = size_t(1) << 16, std::pmr::polymorphic_allocator<T> allocator = {})
+        : BasicSort<T, Compare>(vec, cmp), target(vec), sorted(std::min(sortedPrefix, vec.size())),
+          bufferLimit(std::max<size_t>(bufferLimit, 1)), buffer(allocator) {}
+
+    // Sắp xếp lại toàn bộ vector
     void sort() override {
-        if (this->size > 0)
-            quickSort(0, static_cast<int>(this->size) - 1);
+        sorted = 0;
+        update();
+    }
+
+    // Đưa các phần tử đã được thêm vào cuối vector (bằng push_back, insert...) vào đúng vị trí
+    void update() {
+        // Vector có thể đã cấp phát lại vùng nhớ sau khi thêm phần tử
+        this->data = target.data();
+        this->size = target.size();
+        const size_t n = this->size;
+        if (sorted > n)
+            sorted = n; // vector bị cắt bớt ở cuối: phần còn lại vẫn đã được sắp xếp
+        if (sorted == n)
+            return;
+
+        this->withComparator([&](auto comp) {
+            T* first = this->data;
+            T* middle = first + sorted;
+            T* last = first + n;
+            sort_engine::quickSort(middle, last, comp);
+            if (sorted == 0)
+                return;
+            // Phần tử cũ không lớn hơn phần tử mới nhỏ nhất và phần tử mới không nhỏ hơn phần tử cũ lớn nhất
+            // đã đứng đúng chỗ
+            T* lo = sort_engine::gallopUpperFromBack(first, middle, *middle, comp);
+            T* hi = std::lower_bound(middle, last, *(middle - 1), comp);
+            const size_t shorter = std::min<size_t>(middle - lo, hi - middle);
+            if (buffer.size() < std::min(shorter, bufferLimit)) {
+                sort_engine::note(comp, sort_engine::SortEvent::Scratch,
+                                  (std::min(shorter, bufferLimit) - buffer.size()) * sizeof(T));
+                buffer.resize(std::min(shorter, bufferLimit));
+            }
+            sort_engine::mergeAdaptive(lo, middle, hi, buffer.data(), static_cast<std::ptrdiff_t>(buffer.size()), comp);
+        });
+        sorted = n;
+    }
+
+    void append(const T* values, size_t count) {
+        target.insert(target.end(), values, values + count);
+        update();
+    }
+
+    void append(const std::vector<T>& values) {
+        append(values.data(), values.size());
+    }
+
+    // Di chuyển (không sao chép) các phần tử của values vào cuối vector
+    void append(std::vector<T>&& values) {
+        target.insert(target.end(), std::make_move_iterator(values.begin()), std::make_move_iterator(values.end()));
+        update();
     }
+
+    size_t sortedSize() const { return sorted; }
+
+protected:
+    std::vector<T>& target;
+    size_t sorted;
+    size_t bufferLimit;
+    std::pmr::vector<T> buffer;
 };
 
-// Merge Sort
+// Radix Sort (LSD, mỗi lượt một byte) cho kiểu số nguyên và số thực IEEE.
+// Mỗi giá trị được đổi sang khóa không dấu giữ đúng thứ tự: số nguyên có dấu lật bit dấu, số thực âm đảo toàn bộ bit,
+// số thực dương bật bit dấu; Descending đảo toàn bộ khóa nên không cần lượt đảo ngược riêng.
+// Histogram của mọi byte được đếm trong một lượt duyệt, các byte mà mọi khóa đều giống nhau được bỏ qua.
+// Lưu ý: khác với các thuật toán so sánh, -0.0 luôn đứng trước +0.0 (theo chiều tăng).
+template <size_t Bytes> struct RadixKey;
+template <> struct RadixKey<1> { using type = uint8_t; };
+template <> struct RadixKey<2> { using type = uint16_t; };
+template <> struct RadixKey<4> { using type = uint32_t; };
+template <> struct RadixKey<8> { using type = uint64_t; };
+
 template <typename T>
-class MergeSort : public BasicSort<T> {
+class RadixSort : public BasicSort<T> {
+    static_assert(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value && sizeof(T) <= 8,
+                  "RadixSort hỗ trợ số nguyên và float/double");
+
 public:
     using BasicSort<T>::BasicSort;
 
-    void merge(int left, int mid, int right) {
-        int n1 = mid - left + 1;
-        int n2 = right - mid;
+    // scratch: vùng đệm do người gọi cấp, tối thiểu sz phần tử; nullptr thì RadixSort tự cấp phát một lần
+    RadixSort(T* arr, size_t sz, SortDirection dir, T* scratch)
+        : BasicSort<T>(arr, sz, dir), external(scratch) {}
 
-        std::vector<T> L(n1);
-        std::vector<T> R(n2);
+    RadixSort(std::vector<T>& vec, SortDirection dir, T* scratch)
+        : BasicSort<T>(vec, dir), external(scratch) {}
+
+    void sort() override {
+        const size_t n = this->size;
+        if (n < 2)
+            return;
+        const Key flip = this->direction == SortDirection::Descending ? static_cast<Key>(~Key(0)) : Key(0);
 
-        for (int i = 0; i < n1; i++)
-            L[i] = this->data[left + i];
-        for (int j = 0; j < n2; j++)
-            R[j] = this->data[mid + 1 + j];
+        std::array<std::array<size_t, 256>, sizeof(T)> counts{};
+        for (size_t i = 0; i < n; ++i) {
+            Key key = toKey(this->data[i]) ^ flip;
+            for (size_t d = 0; d < sizeof(T); ++d)
+                ++counts[d][(key >> (8 * d)) & 0xFF];
+        }
 
-        int i = 0, j = 0, k = left;
+        T* src = this->data;
+        T* dst = nullptr;
+        for (size_t d = 0; d < sizeof(T); ++d) {
+            std::array<size_t, 256>& count = counts[d];
+            if (count[((toKey(src[0]) ^ flip) >> (8 * d)) & 0xFF] == n)
+                continue; // mọi khóa có cùng byte này
+            if (dst == nullptr)
+                dst = scratch();
 
-        while (i < n1 && j < n2) {
-            if ((this->direction == SortDirection::Ascending && L[i] <= R[j]) ||
-                (this->direction == SortDirection::Descending && L[i] >= R[j])) {
-                this->data[k] = L[i++];
-            } else {
-                this->data[k] = R[j++];
+            size_t offset = 0;
+            for (size_t& c : count) {
+                size_t bucket = c;
+                c = offset;
+                offset += bucket;
             }
-            k++;
+            for (size_t i = 0; i < n; ++i) {
+                Key key = toKey(src[i]) ^ flip;
+                dst[count[(key >> (8 * d)) & 0xFF]++] = src[i];
+            }
+            std::swap(src, dst);
         }
+        if (src != this->data)
+            std::copy(src, src + n, this->data);
+    }
 
-        while (i < n1) this->data[k++] = L[i++];
-        while (j < n2) this->data[k++] = R[j++];
+    // Khóa không dấu giữ nguyên thứ tự tăng dần của T, dùng chung với KeyValueRadixSort
+    using Key = typename RadixKey<sizeof(T)>::type;
+
+    static Key toKey(T value) {
+        Key bits;
+        std::memcpy(&bits, &value, sizeof(T));
+        const Key sign = Key(1) << (8 * sizeof(T) - 1);
+        if (std::is_floating_point<T>::value) {
+            // Không rẽ nhánh: mask = toàn bit 1 nếu số âm, chỉ bit dấu nếu số dương
+            Key mask = static_cast<Key>(Key(0) - (bits >> (8 * sizeof(T) - 1))) | sign;
+            return static_cast<Key>(bits ^ mask);
+        }
+        if (std::is_signed<T>::value)
+            return static_cast<Key>(bits ^ sign);
+        return bits;
     }
 
-    void sort() override {
-        int n = this->size;
-        for (int curr_size = 1; curr_size < n; curr_size = 2 * curr_size) {
-            for (int left = 0; left < n - 1; left += 2 * curr_size) {
-                int mid = std::min(left + curr_size - 1, n - 1);
-                int right = std::min((left + 2 * curr_size - 1), (n - 1));
-                merge(left, mid, right);
+protected:
+    T* scratch() {
+        if (external != nullptr)
+            return external;
+        if (owned.size() < this->size)
+            owned.resize(this->size);
+        return owned.data();
+    }
+
+    T* external = nullptr;
+    std::pmr::vector<T> owned;
+};
+
+// ----------------------------------------------------------------- Front end tĩnh -----------------------------------------------------------------
+// Các hàm tự do sắp xếp trực tiếp một cặp random-access iterator hoặc một range (vector, deque, mảng, StridedView...)
+// mà không cần tạo đối tượng BasicSort hay gọi hàm ảo sort(), nên trình biên dịch có thể inline toàn bộ.
+// comp có thể là SortDirection, một policy (AscendingOrder, DescendingOrder, byField...) hoặc functor bất kì.
+// Iterator của std::vector được đổi về con trỏ để dùng được kernel SIMD.
+
+// Iterator truy cập ngẫu nhiên đi theo bước stride phần tử, ví dụ để duyệt một cột của ma trận lưu theo hàng
+template <typename T>
+class StridedIterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = typename std::remove_cv<T>::type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    StridedIterator() = default;
+    StridedIterator(T* ptr, difference_type stride) : ptr(ptr), stride(stride) {}
+
+    reference operator*() const { return *ptr; }
+    pointer operator->() const { return ptr; }
+    reference operator[](difference_type n) const { return ptr[n * stride]; }
+
+    StridedIterator& operator++() { ptr += stride; return *this; }
+    StridedIterator& operator--() { ptr -= stride; return *this; }
+    StridedIterator operator++(int) { StridedIterator old = *this; ptr += stride; return old; }
+    StridedIterator operator--(int) { StridedIterator old = *this; ptr -= stride; return old; }
+    StridedIterator& operator+=(difference_type n) { ptr += n * stride; return *this; }
+    StridedIterator& operator-=(difference_type n) { ptr -= n * stride; return *this; }
+
+    friend StridedIterator operator+(StridedIterator it, difference_type n) { return it += n; }
+    friend StridedIterator operator+(difference_type n, StridedIterator it) { return it += n; }
+    friend StridedIterator operator-(StridedIterator it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const StridedIterator& a, const StridedIterator& b) { return (a.ptr - b.ptr) / a.stride; }
+
+    friend bool operator==(const StridedIterator& a, const StridedIterator& b) { return a.ptr == b.ptr; }
+    friend bool operator!=(const StridedIterator& a, const StridedIterator& b) { return a.ptr != b.ptr; }
+    friend bool operator<(const StridedIterator& a, const StridedIterator& b) { return b - a > 0; }
+    friend bool operator>(const StridedIterator& a, const StridedIterator& b) { return b < a; }
+    friend bool operator<=(const StridedIterator& a, const StridedIterator& b) { return !(b < a); }
+    friend bool operator>=(const StridedIterator& a, const StridedIterator& b) { return !(a < b); }
+
+private:
+    T* ptr = nullptr;
+    difference_type stride = 1;
+};
+
+// View gồm count phần tử base[0], base[stride], base[2*stride]... không sở hữu dữ liệu.
+// VD: cột c của ma trận rows x cols lưu theo hàng là StridedView<float>(matrix + c, rows, cols).
+template <typename T>
+class StridedView {
+public:
+    StridedView(T* base, size_t count, std::ptrdiff_t stride) : base(base), count(count), stride(stride) {}
+
+    StridedIterator<T> begin() const { return StridedIterator<T>(base, stride); }
+    StridedIterator<T> end() const { return StridedIterator<T>(base, stride) + static_cast<std::ptrdiff_t>(count); }
+    size_t size() const { return count; }
+    T& operator[](size_t i) const { return base[static_cast<std::ptrdiff_t>(i) * stride]; }
+
+private:
+    T* base;
+    size_t count;
+    std::ptrdiff_t stride;
+};
+
+namespace sort_engine {
+
+template <typename It, typename = void>
+struct IsIterator : std::false_type {};
+
+template <typename It>
+struct IsIterator<It, std::void_t<typename std::iterator_traits<It>::iterator_category>> : std::true_type {};
+
+template <typename Range, typename = void>
+struct IsRange : std::false_type {};
+
+template <typename Range>
+struct IsRange<Range, std::void_t<decltype(std::begin(std::declval<Range&>()))>> : std::true_type {};
+
+template <typename Range>
+using RangeValue = ValueOf<decltype(std::begin(std::declval<Range&>()))>;
+
+// Iterator của std::vector (trừ vector<bool>) trỏ vào bộ nhớ liền kề nên được đổi về con trỏ
+template <typename It>
+auto unwrap(It it) {
+    using T = ValueOf<It>;
+    if constexpr (!std::is_same<T, bool>::value &&
+                  (std::is_same<It, typename std::vector<T>::iterator>::value ||
+                   std::is_same<It, typename std::vector<T>::const_iterator>::value))
+        return &*it;
+    else
+        return it;
+}
+
+// Chạy engine(first, last, comp) trên [first, last) sau khi đổi iterator và bộ so sánh
+template <typename It, typename Cmp, typename Engine>
+void run(It first, It last, const Cmp& comp, Engine engine) {
+    if (first == last)
+        return;
+    auto begin = sort_engine::unwrap(first);
+    auto end = begin + (last - first);
+    sort_engine::withOrder<ValueOf<It>>(comp, [&](auto order) { engine(begin, end, order); });
+}
+
+} // namespace sort_engine
+
+template <typename It, typename Cmp = AscendingOrder<sort_engine::ValueOf<It>>,
+          typename std::enable_if<sort_engine::IsIterator<It>::value, int>::type = 0>
+void selectionSort(It first, It last, Cmp comp = Cmp()) {
+    sort_engine::run(first, last, comp, [](auto begin, auto end, auto order) { sort_engine::selectionSort(begin, end, order); });
+}
+
+template <typename Range, typename Cmp = AscendingOrder<sort_engine::RangeValue<Range>>,
+          typename std::enable_if<sort_engine::IsRange<Range>::value, int>::type = 0>
+void selectionSort(Range&& range, Cmp comp = Cmp()) {
+    selectionSort(std::begin(range), std::end(range), comp);
+}
+
+template <typename It, typename Cmp = AscendingOrder<sort_engine::ValueOf<It>>,
+          typename std::enable_if<sort_engine::IsIterator<It>::value, int>::type = 0>
+void bubbleSort(It first, It last, Cmp comp = Cmp()) {
+    sort_engine::run(first, last, comp, [](auto begin, auto end, auto order) { sort_engine::bubbleSort(begin, end, order); });
+}
+
+template <typename Range, typename Cmp = AscendingOrder<sort_engine::RangeValue<Range>>,
+          typename std::enable_if<sort_engine::IsRange<Range>::value, int>::type = 0>
+void bubbleSort(Range&& range, Cmp comp = Cmp()) {
+    bubbleSort(std::begin(range), std::end(range), comp);
+}
+
+template <typename It, typename Cmp = AscendingOrder<sort_engine::ValueOf<It>>,
+          typename std::enable_if<sort_engine::IsIterator<It>::value, int>::type = 0>
+void insertionSort(It first, It last, Cmp comp = Cmp()) {
+    sort_engine::run(first, last, comp, [](auto begin, auto end, auto order) { sort_engine::insertionSort(begin, end, order); });
+}
+
+template <typename Range, typename Cmp = AscendingOrder<sort_engine::RangeValue<Range>>,
+          typename std::enable_if<sort_engine::IsRange<Range>::value, int>::type = 0>
+void insertionSort(Range&& range, Cmp comp = Cmp()) {
+    insertionSort(std::begin(range), std::end(range), comp);
+}
+
+template <typename It, typename Cmp = AscendingOrder<sort_engine::ValueOf<It>>,
+          typename std::enable_if<sort_engine::IsIterator<It>::value, int>::type = 0>
+void quickSort(It first, It last, Cmp comp = Cmp()) {
+    sort_engine::run(first, last, comp, [](auto begin, auto end, auto order) { sort_engine::quickSort(begin, end, order); });
+}
+
+template <typename Range, typename Cmp = AscendingOrder<sort_engine::RangeValue<Range>>,
+          typename std::enable_if<sort_engine::IsRange<Range>::value, int>::type = 0>
+void quickSort(Range&& range, Cmp comp = Cmp()) {
+    quickSort(std::begin(range), std::end(range), comp);
+}
+
+// Merge sort ổn định; vùng đệm chỉ được cấp phát khi dữ liệu chưa phải một run duy nhất
+template <typename It, typename Cmp = AscendingOrder<sort_engine::ValueOf<It>>,
+          typename std::enable_if<sort_engine::IsIterator<It>::value, int>::type = 0>
+void mergeSort(It first, It last, Cmp comp = Cmp()) {
+    std::pmr::vector<sort_engine::ValueOf<It>> scratch;
+    sort_engine::run(first, last, comp, [&scratch](auto begin, auto end, auto order) {
+        sort_engine::mergeSort(begin, end, [&] {
+            scratch.resize(static_cast<size_t>(end - begin));
+            return scratch.data();
+        }, order);
+    });
+}
+
+template <typename Range, typename Cmp = AscendingOrder<sort_engine::RangeValue<Range>>,
+          typename std::enable_if<sort_engine::IsRange<Range>::value, int>::type = 0>
+void mergeSort(Range&& range, Cmp comp = Cmp()) {
+    mergeSort(std::begin(range), std::end(range), comp);
+}
+
+// Trộn hai dãy đã sắp xếp theo comp [first1, last1) và [first2, last2) vào out (sao chép như std::merge), trả về vị trí
+// sau phần tử cuối cùng được ghi. Mảng / vector float, int32_t, int64_t, double với SortDirection / std::less /
+// std::greater dùng bitonic merge AVX2: không có nhánh phụ thuộc dữ liệu nhưng không ổn định (các phần tử bằng nhau,
+// VD -0.0 và +0.0, có thể đổi thứ tự); các trường hợp khác trộn ổn định như std::merge.
+template <typename InA, typename InB, typename Out, typename Cmp = AscendingOrder<sort_engine::ValueOf<InA>>,
+          typename std::enable_if<sort_engine::IsIterator<InA>::value, int>::type = 0>
+Out mergeSorted(InA first1, InA last1, InB first2, InB last2, Out out, Cmp comp = Cmp()) {
+    using T = sort_engine::ValueOf<InA>;
+    constexpr bool contiguousOut = std::is_same<Out, T*>::value || std::is_same<Out, typename std::vector<T>::iterator>::value;
+    if constexpr (contiguousOut && std::is_same<sort_engine::ValueOf<InB>, T>::value && SimdMergeKernel<T>::block != 0) {
+        if (first1 != last1 && first2 != last2) {
+            auto a = sort_engine::unwrap(first1);
+            auto b = sort_engine::unwrap(first2);
+            if constexpr (std::is_pointer<decltype(a)>::value && std::is_pointer<decltype(b)>::value) {
+                T* begin = &*out;
+                T* end = begin;
+                sort_engine::withOrder<T>(comp, [&](auto order) {
+                    end = sort_engine::simdMergeRuns<T>(a, a + (last1 - first1), b, b + (last2 - first2), begin, order);
+                });
+                return out + (end - begin);
             }
         }
     }
-};
+    sort_engine::withOrder<T>(comp, [&](auto order) { out = std::merge(first1, last1, first2, last2, out, order); });
+    return out;
+}
+
+template <typename RangeA, typename RangeB, typename Out, typename Cmp = AscendingOrder<sort_engine::RangeValue<RangeA>>,
+          typename std::enable_if<sort_engine::IsRange<RangeA>::value, int>::type = 0>
+Out mergeSorted(const RangeA& a, const RangeB& b, Out out, Cmp comp = Cmp()) {
+    return mergeSorted(std::begin(a), std::end(a), std::begin(b), std::end(b), out, comp);
+}
+
+// Chọn phần tử thứ nth theo thứ tự comp (introselect) và sắp xếp một phần [first, middle), xem QuickSelect
+template <typename It, typename Cmp = AscendingOrder<sort_engine::ValueOf<It>>,
+          typename std::enable_if<sort_engine::IsIterator<It>::value, int>::type = 0>
+void nthElement(It first, It nth, It last, Cmp comp = Cmp()) {
+    if (nth == last)
+        return;
+    const auto offset = nth - first;
+    sort_engine::run(first, last, comp, [offset](auto begin, auto end, auto order) {
+        sort_engine::nthElement(begin, begin + offset, end, order);
+    });
+}
+
+template <typename It, typename Cmp = AscendingOrder<sort_engine::ValueOf<It>>,
+          typename std::enable_if<sort_engine::IsIterator<It>::value, int>::type = 0>
+void partialSort(It first, It middle, It last, Cmp comp = Cmp()) {
+    const auto offset = middle - first;
+    sort_engine::run(first, last, comp, [offset](auto begin, auto end, auto order) {
+        sort_engine::partialSort(begin, begin + offset, end, order);
+    });
+}
+
+// Radix sort cần bộ nhớ liền kề: nhận con trỏ hoặc một container có data()/size() (vector, array...)
+template <typename T>
+void radixSort(T* first, T* last, SortDirection dir = SortDirection::Ascending) {
+    RadixSort<T> sorter(first, static_cast<size_t>(last - first), dir);
+    sorter.RadixSort<T>::sort();
+}
+
+template <typename Container>
+auto radixSort(Container& container, SortDirection dir = SortDirection::Ascending)
+    -> decltype(container.data(), container.size(), void()) {
+    radixSort(container.data(), container.data() + container.size(), dir);
+}
 
-#endif
\ No newline at end of file
+#endif
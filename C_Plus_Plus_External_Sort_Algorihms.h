@@ -0,0 +1,381 @@
+#ifndef _C_PLUS_PLUS_EXTERNAL_SORT_ALGORIHMS_
+#define _C_PLUS_PLUS_EXTERNAL_SORT_ALGORIHMS_
+
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <future>
+#include <filesystem>
+#include <stdexcept>
+#include <type_traits>
+#include <random>
+#include "C_Plus_Plus_Data_Structure_Algorihms.h"
+
+// ----------------------------------------------------------------- External Sort -----------------------------------------------------------------
+// Sắp xếp file nhị phân chứa các phần tử T kích thước cố định (ghi liên tiếp, không header) khi dữ liệu lớn hơn RAM:
+//  1. Tạo run: đọc từng đoạn vừa ngân sách bộ nhớ, sắp xếp bằng QuickSort hoặc MergeSort rồi ghi ra file tạm.
+//     Đoạn kế tiếp được đọc nền trong lúc đoạn hiện tại đang được sắp xếp và ghi.
+//  2. Trộn k đường bằng cây loser tree, mỗi run được đọc tuần tự qua hai buffer lớn (một buffer đang dùng,
+//     một buffer đang được đọc nền), đầu ra cũng được ghi nền qua hai buffer.
+// Nếu số run vượt quá số đường trộn tối đa mà ngân sách bộ nhớ cho phép thì trộn thành nhiều lượt.
+
+enum class RunAlgorithm {
+    Quick,  // nhanh hơn, cần 2 buffer đoạn
+    Merge   // ổn định (kết quả cuối cùng giữ thứ tự các phần tử bằng nhau), cần thêm 1 buffer tạm
+};
+
+struct ExternalSortConfig {
+    size_t memoryBytes = size_t(256) << 20;   // tổng bộ nhớ cho buffer dữ liệu ở cả hai giai đoạn
+    size_t ioBlockBytes = size_t(4) << 20;    // kích thước tối thiểu mỗi lần đọc/ghi khi trộn, quyết định số đường trộn tối đa
+    RunAlgorithm algorithm = RunAlgorithm::Quick;
+    std::string tempDirectory;                // rỗng = std::filesystem::temp_directory_path()
+};
+
+namespace external_detail {
+
+// FILE* tự đóng khi ra khỏi phạm vi; tắt buffer của stdio vì mọi lần đọc/ghi đều là khối lớn
+struct FileCloser {
+    void operator()(std::FILE* file) const { std::fclose(file); }
+};
+using FileHandle = std::unique_ptr<std::FILE, FileCloser>;
+
+inline FileHandle openFile(const std::string& path, const char* mode) {
+    FileHandle file(std::fopen(path.c_str(), mode));
+    if (!file)
+        throw std::runtime_error("ExternalSort: cannot open " + path);
+    std::setvbuf(file.get(), nullptr, _IONBF, 0);
+    return file;
+}
+
+template <typename T>
+void readExact(std::FILE* file, T* out, size_t count) {
+    if (count != 0 && std::fread(out, sizeof(T), count, file) != count)
+        throw std::runtime_error("ExternalSort: short read");
+}
+
+template <typename T>
+void writeExact(std::FILE* file, const T* in, size_t count) {
+    if (count != 0 && std::fwrite(in, sizeof(T), count, file) != count)
+        throw std::runtime_error("ExternalSort: write failed");
+}
+
+// Đọc tuần tự count phần tử của một file qua hai buffer: trong lúc front()/pop() dùng buffer hiện tại,
+// khối kế tiếp đã được đọc nền vào buffer còn lại
+template <typename T>
+class BlockReader {
+public:
+    BlockReader(const std::string& path, uint64_t count, size_t blockElems)
+        : file(openFile(path, "rb")), remaining(count), current(blockElems), next(blockElems) {
+        prefetch();
+        advance();
+    }
+
+    bool empty() const { return pos == currentSize; }
+    const T& front() const { return current[pos]; }
+
+    void pop() {
+        if (++pos == currentSize)
+            advance();
+    }
+
+private:
+    void prefetch() {
+        const size_t count = static_cast<size_t>(std::min<uint64_t>(remaining, next.size()));
+        remaining -= count;
+        if (count == 0)
+            return;
+        pending = std::async(std::launch::async, [this, count] {
+            readExact(file.get(), next.data(), count);
+            return count;
+        });
+    }
+
+    void advance() {
+        pos = 0;
+        currentSize = 0;
+        if (!pending.valid())
+            return;
+        currentSize = pending.get();
+        current.swap(next);
+        prefetch();
+    }
+
+    FileHandle file;
+    uint64_t remaining;
+    std::vector<T> current;
+    std::vector<T> next;
+    size_t pos = 0;
+    size_t currentSize = 0;
+    std::future<size_t> pending;   // khai báo cuối để bị huỷ (và chờ việc đọc nền xong) trước các buffer và file
+};
+
+// Ghi tuần tự qua hai buffer: khi buffer hiện tại đầy, nó được ghi nền và việc ghi tiếp chuyển sang buffer còn lại
+template <typename T>
+class BlockWriter {
+public:
+    BlockWriter(const std::string& path, size_t blockElems)
+        : file(openFile(path, "wb")), current(blockElems), next(blockElems) {}
+
+    void push(const T& value) {
+        current[pos++] = value;
+        if (pos == current.size())
+            flush();
+    }
+
+    // Ghi phần còn lại và đóng file; lỗi ghi được ném ra ở đây thay vì bị nuốt trong destructor
+    void finish() {
+        flush();
+        if (pending.valid())
+            pending.get();
+        if (std::fflush(file.get()) != 0 || std::fclose(file.release()) != 0)
+            throw std::runtime_error("ExternalSort: write failed");
+    }
+
+private:
+    void flush() {
+        if (pending.valid())
+            pending.get();
+        current.swap(next);
+        const size_t count = pos;
+        pos = 0;
+        if (count != 0)
+            pending = std::async(std::launch::async, [this, count] { writeExact(file.get(), next.data(), count); });
+    }
+
+    FileHandle file;
+    std::vector<T> current;
+    std::vector<T> next;
+    size_t pos = 0;
+    std::future<void> pending;     // khai báo cuối để bị huỷ (và chờ việc ghi nền xong) trước các buffer và file
+};
+
+// Cây loser tree trên k nguồn đã sắp xếp: mỗi nút trong giữ nguồn thua ở trận đấu tại nút đó, winner() là nguồn
+// có phần tử nhỏ nhất. Sau khi lấy phần tử của winner chỉ cần đấu lại log2(k) trận trên đường từ lá lên gốc.
+// Khi bằng nhau, nguồn có chỉ số nhỏ hơn thắng, nên trộn các run theo thứ tự tạo ra là trộn ổn định.
+template <typename Source, typename Cmp>
+class LoserTree {
+public:
+    LoserTree(std::vector<Source*> sources, Cmp comp) : sources(std::move(sources)), comp(comp), tree(this->sources.size()) {
+        if (!this->sources.empty())
+            best = build(1);
+    }
+
+    bool empty() const { return sources.empty() || sources[best]->empty(); }
+    Source& winner() const { return *sources[best]; }
+
+    // Gọi sau khi đã pop() phần tử đầu của winner()
+    void replay() {
+        size_t candidate = best;
+        for (size_t node = (candidate + sources.size()) / 2; node >= 1; node /= 2) {
+            if (beats(tree[node], candidate))
+                std::swap(tree[node], candidate);
+        }
+        best = candidate;
+    }
+
+private:
+    // Các nút trong đánh số 1..k-1, lá của nguồn i ở vị trí k + i
+    size_t build(size_t node) {
+        const size_t k = sources.size();
+        if (node >= k)
+            return node - k;
+        size_t left = build(2 * node);
+        size_t right = build(2 * node + 1);
+        if (beats(left, right)) {
+            tree[node] = right;
+            return left;
+        }
+        tree[node] = left;
+        return right;
+    }
+
+    // Nguồn đã hết thua mọi nguồn khác
+    bool beats(size_t a, size_t b) const {
+        if (sources[a]->empty())
+            return false;
+        if (sources[b]->empty())
+            return true;
+        if (comp(sources[b]->front(), sources[a]->front()))
+            return false;
+        return comp(sources[a]->front(), sources[b]->front()) || a < b;
+    }
+
+    std::vector<Source*> sources;
+    Cmp comp;
+    std::vector<size_t> tree;
+    size_t best = 0;
+};
+
+} // namespace external_detail
+
+template <typename T, typename Compare = DirectionOrder<T>>
+class ExternalSort {
+    static_assert(std::is_trivially_copyable<T>::value, "ExternalSort reads and writes raw bytes of T");
+
+public:
+    ExternalSort(std::string inputPath, std::string outputPath, Compare cmp = Compare(),
+                 ExternalSortConfig config = ExternalSortConfig())
+        : inputPath(std::move(inputPath)), outputPath(std::move(outputPath)), comp(cmp), config(std::move(config)) {}
+
+    // outputPath có thể trùng inputPath: file đầu vào được đọc hết trước khi mở file đầu ra
+    void sort() {
+        namespace fs = std::filesystem;
+        const uint64_t bytes = fs::file_size(inputPath);
+        if (bytes % sizeof(T) != 0)
+            throw std::runtime_error("ExternalSort: file size is not a multiple of the element size");
+        const uint64_t total = bytes / sizeof(T);
+
+        const fs::path tempDir = config.tempDirectory.empty() ? fs::temp_directory_path() : fs::path(config.tempDirectory);
+        std::vector<std::string> runs;
+        // Xoá mọi file tạm đã tạo kể cả khi có ngoại lệ
+        struct TempFiles {
+            std::vector<std::string>& paths;
+            ~TempFiles() {
+                std::error_code ignored;
+                for (const std::string& path : paths)
+                    std::filesystem::remove(path, ignored);
+                paths.clear();
+            }
+        } cleanup{temporaries};
+        token = std::random_device()();
+
+        createRuns(total, tempDir, runs);
+        if (runs.empty())
+            return;
+        mergeAll(tempDir, runs);
+    }
+
+    // Số run được tạo ra ở lượt sắp xếp gần nhất (1 nghĩa là dữ liệu vừa bộ nhớ, không cần trộn)
+    size_t runCount() const { return createdRuns; }
+    // Số lượt trộn đã thực hiện ở lượt sắp xếp gần nhất
+    size_t mergePasses() const { return passes; }
+
+private:
+    size_t elementsFor(size_t bytes) const { return std::max<size_t>(bytes / sizeof(T), 1); }
+
+    std::string tempPath(const std::filesystem::path& dir) {
+        temporaries.push_back((dir / ("external_sort_" + std::to_string(token) + "_" + std::to_string(temporaries.size()) + ".run")).string());
+        return temporaries.back();
+    }
+
+    void sortChunk(T* chunk, size_t count, T* scratch) {
+        if (config.algorithm == RunAlgorithm::Merge) {
+            MergeSort<T, Compare> sorter(chunk, count, comp, scratch);
+            sorter.MergeSort<T, Compare>::sort();
+        } else {
+            QuickSort<T, Compare> sorter(chunk, count, comp);
+            sorter.QuickSort<T, Compare>::sort();
+        }
+    }
+
+    // Giai đoạn 1: đọc đoạn r + 1 song song với việc sắp xếp và ghi đoạn r.
+    // Nếu chỉ có một đoạn, kết quả được ghi thẳng ra outputPath và runs để rỗng.
+    void createRuns(uint64_t total, const std::filesystem::path& tempDir, std::vector<std::string>& runs) {
+        using namespace external_detail;
+        const size_t buffers = config.algorithm == RunAlgorithm::Merge ? 3 : 2;
+        const size_t chunk = static_cast<size_t>(std::min<uint64_t>(elementsFor(config.memoryBytes / buffers), std::max<uint64_t>(total, 1)));
+        const uint64_t chunkCount = (total + chunk - 1) / chunk;
+        createdRuns = static_cast<size_t>(chunkCount);
+        passes = 0;
+
+        std::vector<T> buffer[2];
+        buffer[0].resize(chunk);
+        if (chunkCount > 1)
+            buffer[1].resize(chunk);
+        std::vector<T> scratch(config.algorithm == RunAlgorithm::Merge ? chunk : 0);
+
+        FileHandle input = openFile(inputPath, "rb");
+        auto countOf = [&](uint64_t r) { return static_cast<size_t>(std::min<uint64_t>(chunk, total - r * chunk)); };
+        std::future<void> pending;
+        if (chunkCount > 0)
+            pending = std::async(std::launch::async, [&] { readExact(input.get(), buffer[0].data(), countOf(0)); });
+
+        for (uint64_t r = 0; r < chunkCount; ++r) {
+            pending.get();
+            T* current = buffer[r % 2].data();
+            if (r + 1 < chunkCount) {
+                T* nextChunk = buffer[(r + 1) % 2].data();
+                const size_t nextCount = countOf(r + 1);
+                pending = std::async(std::launch::async, [&input, nextChunk, nextCount] { readExact(input.get(), nextChunk, nextCount); });
+            }
+            sortChunk(current, countOf(r), scratch.data());
+
+            if (chunkCount == 1) {
+                input.reset();
+                FileHandle output = openFile(outputPath, "wb");
+                writeExact(output.get(), current, countOf(r));
+                if (std::fclose(output.release()) != 0)
+                    throw std::runtime_error("ExternalSort: write failed");
+                return;
+            }
+            runs.push_back(tempPath(tempDir));
+            FileHandle run = openFile(runs.back(), "wb");
+            writeExact(run.get(), current, countOf(r));
+            if (std::fclose(run.release()) != 0)
+                throw std::runtime_error("ExternalSort: write failed");
+        }
+        if (chunkCount == 0) {
+            input.reset();
+            openFile(outputPath, "wb");
+        }
+    }
+
+    // Giai đoạn 2: mỗi đường trộn và đầu ra dùng hai buffer, nên số đường tối đa là memoryBytes / (2 * ioBlockBytes) - 1
+    void mergeAll(const std::filesystem::path& tempDir, std::vector<std::string>& runs) {
+        const size_t blockBytes = std::max<size_t>(config.ioBlockBytes, sizeof(T));
+        const size_t maxFanIn = std::max<size_t>(config.memoryBytes / (2 * blockBytes), 3) - 1;
+        while (runs.size() > maxFanIn) {
+            std::vector<std::string> merged;
+            for (size_t first = 0; first < runs.size(); first += maxFanIn) {
+                const size_t last = std::min(runs.size(), first + maxFanIn);
+                merged.push_back(tempPath(tempDir));
+                mergeGroup(runs, first, last, merged.back());
+                // Xoá run đã trộn ngay để dung lượng đĩa tạm không vượt quá khoảng hai lần dữ liệu
+                std::error_code ignored;
+                for (size_t r = first; r < last; ++r)
+                    std::filesystem::remove(runs[r], ignored);
+            }
+            runs.swap(merged);
+            ++passes;
+        }
+        mergeGroup(runs, 0, runs.size(), outputPath);
+        ++passes;
+    }
+
+    void mergeGroup(const std::vector<std::string>& runs, size_t first, size_t last, const std::string& target) {
+        using namespace external_detail;
+        const size_t ways = last - first;
+        const size_t blockElems = elementsFor(config.memoryBytes / (2 * (ways + 1)));
+
+        std::vector<std::unique_ptr<BlockReader<T>>> readers;
+        std::vector<BlockReader<T>*> sources;
+        for (size_t r = first; r < last; ++r) {
+            readers.push_back(std::make_unique<BlockReader<T>>(runs[r], std::filesystem::file_size(runs[r]) / sizeof(T), blockElems));
+            sources.push_back(readers.back().get());
+        }
+        BlockWriter<T> writer(target, blockElems);
+        sort_engine::withOrder<T>(comp, [&](auto order) {
+            LoserTree<BlockReader<T>, decltype(order)> tree(sources, order);
+            while (!tree.empty()) {
+                BlockReader<T>& source = tree.winner();
+                writer.push(source.front());
+                source.pop();
+                tree.replay();
+            }
+        });
+        writer.finish();
+    }
+
+    std::string inputPath;
+    std::string outputPath;
+    Compare comp;
+    ExternalSortConfig config;
+    size_t createdRuns = 0;
+    size_t passes = 0;
+    uint64_t token = 0;                     // phân biệt file tạm của các lần sắp xếp chạy đồng thời
+    std::vector<std::string> temporaries;   // mọi file tạm đã tạo trong lần sort() hiện tại
+};
+
+#endif
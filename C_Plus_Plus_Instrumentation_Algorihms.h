@@ -0,0 +1,272 @@
+#ifndef _C_PLUS_PLUS_INSTRUMENTATION_ALGORIHMS_
+#define _C_PLUS_PLUS_INSTRUMENTATION_ALGORIHMS_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include "C_Plus_Plus_Data_Structure_Algorihms.h"
+
+#if defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// ----------------------------------------------------------------- Instrumentation -----------------------------------------------------------------
+// Đo một lần sort(): thời gian, số phép so sánh / đổi chỗ / di chuyển phần tử, số byte vùng đệm, độ sâu đệ quy lớn nhất
+// và (trên Linux, nếu được phép) bộ đếm phần cứng perf_event.
+// Các phép đếm được bật bằng cách dùng CountingOrder làm Compare của lớp sắp xếp, ví dụ QuickSort<float, CountingOrder<float>>.
+// Lớp dùng bộ so sánh thường không bị ảnh hưởng: các điểm đo trong sort_engine bị loại bỏ lúc biên dịch.
+// Lưu ý:
+//  - mỗi phép đếm là một atomic, nên thời gian và bộ đếm phần cứng của lần chạy có đếm cao hơn lần chạy không đếm;
+//    muốn số đo phần cứng "sạch" hãy gọi SortProbe::measure() với lớp dùng bộ so sánh thường
+//  - heapsort dự phòng, std::partition của ParallelQuickSort và các thao tác heap chỉ được đếm phép so sánh
+//  - phần tử do kernel SIMD sắp xếp được đếm riêng (vectorized), không tính vào comparisons
+//  - RadixSort không dùng bộ so sánh nên chỉ có thời gian và bộ đếm phần cứng
+
+// Bộ đếm dùng chung giữa các bản sao của CountingOrder (bộ so sánh được truyền theo giá trị và sao chép sang các luồng)
+struct SortCounters {
+    std::atomic<uint64_t> comparisons{0};
+    std::atomic<uint64_t> swaps{0};
+    std::atomic<uint64_t> moves{0};
+    std::atomic<uint64_t> scratchBytes{0};
+    std::atomic<uint64_t> vectorized{0};
+    std::atomic<uint64_t> maxDepth{0};
+
+    void reset() {
+        for (std::atomic<uint64_t>* counter : {&comparisons, &swaps, &moves, &scratchBytes, &vectorized, &maxDepth})
+            counter->store(0, std::memory_order_relaxed);
+    }
+
+    void record(sort_engine::SortEvent event, size_t amount) {
+        // Độ sâu đệ quy hiện tại là của từng luồng: các tác vụ song song có stack riêng
+        static thread_local uint64_t depth = 0;
+        switch (event) {
+        case sort_engine::SortEvent::Swap:    swaps.fetch_add(amount, std::memory_order_relaxed); break;
+        case sort_engine::SortEvent::Move:    moves.fetch_add(amount, std::memory_order_relaxed); break;
+        case sort_engine::SortEvent::Scratch: scratchBytes.fetch_add(amount, std::memory_order_relaxed); break;
+        case sort_engine::SortEvent::Leave:   --depth; break;
+        case sort_engine::SortEvent::Enter: {
+            uint64_t current = ++depth;
+            uint64_t deepest = maxDepth.load(std::memory_order_relaxed);
+            while (current > deepest && !maxDepth.compare_exchange_weak(deepest, current, std::memory_order_relaxed)) {}
+            break;
+        }
+        }
+    }
+};
+
+// Bộ so sánh đếm số lần được gọi và nhận các sự kiện từ sort_engine, thứ tự do Compare bên trong quyết định.
+// withOrder() đổi phần bên trong (DirectionOrder -> AscendingOrder / DescendingOrder) như với bộ so sánh thường,
+// nên lớp sắp xếp vẫn đi đúng nhánh thuật toán (kể cả kernel SIMD) như khi không đo.
+template <typename T, typename Compare = DirectionOrder<T>>
+struct CountingOrder : sort_engine::InstrumentedOrder {
+    Compare inner;
+    SortCounters* counters;
+
+    CountingOrder(Compare cmp = Compare(), SortCounters* counters = nullptr) : inner(cmp), counters(counters) {}
+
+    bool operator()(const T& a, const T& b) const {
+        if (counters != nullptr)
+            counters->comparisons.fetch_add(1, std::memory_order_relaxed);
+        return inner(a, b);
+    }
+
+    void note(sort_engine::SortEvent event, size_t amount) const {
+        if (counters != nullptr)
+            counters->record(event, amount);
+    }
+
+    template <typename Other>
+    CountingOrder<T, Other> rebind(Other cmp) const {
+        return CountingOrder<T, Other>(cmp, counters);
+    }
+};
+
+// Kernel SIMD được chọn theo bộ so sánh bên trong; số phần tử nó sắp xếp được ghi vào vectorized
+template <typename T, typename Compare>
+size_t simdSortCapacity(CountingOrder<T, Compare> comp) {
+    return simdSortCapacity<T>(comp.inner);
+}
+
+template <typename T, typename Compare>
+bool simdSmallSort(T* first, size_t n, CountingOrder<T, Compare> comp) {
+    if (!simdSmallSort(first, n, comp.inner))
+        return false;
+    if (comp.counters != nullptr)
+        comp.counters->vectorized.fetch_add(n, std::memory_order_relaxed);
+    return true;
+}
+
+// Bộ đếm phần cứng trong user space, -1 nghĩa là không đọc được (không phải Linux, kernel không cho phép
+// theo perf_event_paranoid, hoặc máy ảo không cung cấp sự kiện đó)
+struct PerfCounters {
+    int64_t cycles = -1;
+    int64_t instructions = -1;
+    int64_t branchMisses = -1;
+    int64_t cacheMisses = -1;  // last-level cache
+
+    bool available() const { return cycles >= 0 || instructions >= 0 || branchMisses >= 0 || cacheMisses >= 0; }
+};
+
+// Mở các sự kiện perf_event cho luồng hiện tại và các luồng nó tạo ra sau đó (inherit). Luồng nền đã có từ trước, VD của
+// sharedWorkStealingPool mà ParallelQuickSort / ParallelMergeSort dùng lại giữa các lần sort(), không được tính: chỉ phần
+// việc do luồng gọi xử lí được đếm. Mỗi sự kiện mở độc lập: sự kiện nào lỗi thì bỏ qua.
+class PerfEventGroup {
+public:
+    // enabled = false: không mở sự kiện nào, stop() trả về toàn -1
+    explicit PerfEventGroup(bool enabled = true) {
+#if defined(__linux__)
+        if (!enabled)
+            return;
+        const uint64_t configs[events] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                          PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES};
+        for (size_t i = 0; i < events; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = configs[i];
+            attr.disabled = 1;
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fds[i] = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#else
+        (void)enabled;
+#endif
+    }
+
+    ~PerfEventGroup() {
+#if defined(__linux__)
+        for (int fd : fds)
+            if (fd >= 0)
+                ::close(fd);
+#endif
+    }
+
+    PerfEventGroup(const PerfEventGroup&) = delete;
+    PerfEventGroup& operator=(const PerfEventGroup&) = delete;
+
+    void start() {
+#if defined(__linux__)
+        for (int fd : fds) {
+            if (fd >= 0) {
+                ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    PerfCounters stop() {
+        int64_t values[events] = {-1, -1, -1, -1};
+#if defined(__linux__)
+        for (size_t i = 0; i < events; ++i) {
+            if (fds[i] < 0)
+                continue;
+            ::ioctl(fds[i], PERF_EVENT_IOC_DISABLE, 0);
+            uint64_t value = 0;
+            if (::read(fds[i], &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value)))
+                values[i] = static_cast<int64_t>(value);
+        }
+#endif
+        PerfCounters result;
+        result.cycles = values[0];
+        result.instructions = values[1];
+        result.branchMisses = values[2];
+        result.cacheMisses = values[3];
+        return result;
+    }
+
+private:
+    static constexpr size_t events = 4;
+    int fds[events] = {-1, -1, -1, -1};
+};
+
+// Kết quả đo của một lần sort()
+struct SortStats {
+    size_t size = 0;
+    double milliseconds = 0;
+    uint64_t comparisons = 0;
+    uint64_t swaps = 0;
+    uint64_t moves = 0;
+    uint64_t scratchBytes = 0;
+    uint64_t vectorized = 0;   // số phần tử được kernel SIMD sắp xếp
+    uint64_t maxDepth = 0;     // số cấp đệ quy lồng nhau sâu nhất trên một luồng
+    PerfCounters perf;
+
+    std::string toJson() const {
+        std::ostringstream out;
+        auto counter = [&](const char* name, int64_t value) {
+            out << ", \"" << name << "\": ";
+            if (value >= 0)
+                out << value;
+            else
+                out << "null";
+        };
+        out << "{\"size\": " << size << ", \"milliseconds\": " << milliseconds << ", \"comparisons\": " << comparisons
+            << ", \"swaps\": " << swaps << ", \"moves\": " << moves << ", \"scratch_bytes\": " << scratchBytes
+            << ", \"vectorized\": " << vectorized << ", \"max_depth\": " << maxDepth;
+        counter("cycles", perf.cycles);
+        counter("instructions", perf.instructions);
+        counter("branch_misses", perf.branchMisses);
+        counter("cache_misses", perf.cacheMisses);
+        out << "}";
+        return out.str();
+    }
+};
+
+// Giữ bộ đếm cho một hoặc nhiều lần đo.
+// VD: SortProbe probe;
+//     QuickSort<float, CountingOrder<float>> sorter(vec, probe.order<float>(SortDirection::Ascending));
+//     std::cout << probe.measure(sorter).toJson();
+class SortProbe {
+public:
+    // Bộ so sánh đếm gắn với probe này; probe phải sống lâu hơn lớp sắp xếp dùng nó
+    template <typename T>
+    CountingOrder<T> order(SortDirection direction = SortDirection::Ascending) {
+        return CountingOrder<T>(direction, &counters);
+    }
+
+    template <typename T, typename Compare, typename = std::enable_if_t<!std::is_same<Compare, SortDirection>::value>>
+    CountingOrder<T, Compare> order(Compare cmp) {
+        return CountingOrder<T, Compare>(cmp, &counters);
+    }
+
+    // Xóa bộ đếm, chạy sorter.sort() một lần và trả về kết quả. hardware = false bỏ qua perf_event.
+    // Sorter là bất kì lớp con nào của BasicSort; nếu nó không dùng bộ so sánh của probe thì các phép đếm bằng 0.
+    template <typename Sorter>
+    SortStats measure(Sorter& sorter, bool hardware = true) {
+        using Clock = std::chrono::steady_clock;
+        counters.reset();
+        SortStats stats;
+        stats.size = sorter.length();
+
+        PerfEventGroup events(hardware);
+        events.start();
+        auto start = Clock::now();
+        sorter.sort();
+        auto end = Clock::now();
+        stats.perf = events.stop();
+
+        stats.milliseconds = std::chrono::duration<double, std::milli>(end - start).count();
+        stats.comparisons = counters.comparisons.load(std::memory_order_relaxed);
+        stats.swaps = counters.swaps.load(std::memory_order_relaxed);
+        stats.moves = counters.moves.load(std::memory_order_relaxed);
+        stats.scratchBytes = counters.scratchBytes.load(std::memory_order_relaxed);
+        stats.vectorized = counters.vectorized.load(std::memory_order_relaxed);
+        stats.maxDepth = counters.maxDepth.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    SortCounters counters;
+};
+
+#endif
@@ -0,0 +1,247 @@
+#ifndef _C_PLUS_PLUS_KEY_VALUE_SORT_ALGORIHMS_
+#define _C_PLUS_PLUS_KEY_VALUE_SORT_ALGORIHMS_
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "C_Plus_Plus_Data_Structure_Algorihms.h"
+
+// ----------------------------------------------------------------- Key / Value Sort -----------------------------------------------------------------
+// Sắp xếp theo khóa khi khóa và dữ liệu đi kèm (payload) nằm ở hai mảng riêng (structure-of-arrays):
+// các phép so sánh chỉ chạm vào mảng khóa dày đặc, còn payload (có thể rất lớn) chỉ được di chuyển một lần ở cuối
+// theo hoán vị tìm được. argsort() trả về chính hoán vị đó mà không thay đổi dữ liệu.
+
+enum class KeyValueAlgorithm {
+    Quick,  // introsort trên cặp (khóa, chỉ số), không ổn định
+    Merge,  // merge sort trên cặp (khóa, chỉ số), ổn định
+    Radix   // LSD radix trên mảng khóa và mảng chỉ số riêng, ổn định; chỉ cho khóa số và SortDirection
+};
+
+namespace key_value_detail {
+
+// Khóa được sao chép cùng chỉ số gốc vào một mảng nhỏ gọn, nên quá trình sắp xếp chỉ di chuyển vài byte mỗi phần tử
+template <typename K, typename Index>
+struct KeyIndex {
+    K key;
+    Index index;
+};
+
+// Tìm hoán vị order (sorted[i] = keys[order[i]]) bằng QuickSort/MergeSort của sort_engine.
+// keys là con trỏ (khóa được sao chép) hoặc std::move_iterator (khóa được di chuyển, dùng được với khóa move-only).
+// Nếu sortedKeys khác nullptr, khóa đã sắp xếp được ghi vào đó (có thể trùng keys).
+template <typename Index, typename K, typename Source, typename Cmp>
+void orderByComparison(Source keys, size_t n, Index* order, Cmp comp, bool stable, K* sortedKeys) {
+    std::pmr::vector<KeyIndex<K, Index>> pairs;
+    pairs.reserve(n);
+    for (size_t i = 0; i < n; ++i, ++keys)
+        pairs.push_back({*keys, static_cast<Index>(i)});
+
+    auto byKey = [comp](const KeyIndex<K, Index>& a, const KeyIndex<K, Index>& b) { return comp(a.key, b.key); };
+    if (stable) {
+        std::pmr::vector<KeyIndex<K, Index>> scratch;
+        sort_engine::mergeSort(pairs.data(), pairs.data() + n, [&] {
+            scratch.resize(n);
+            return scratch.data();
+        }, byKey);
+    } else {
+        sort_engine::quickSort(pairs.data(), pairs.data() + n, byKey);
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        order[i] = pairs[i].index;
+        if (sortedKeys != nullptr)
+            sortedKeys[i] = std::move(pairs[i].key);
+    }
+}
+
+// Tìm hoán vị order bằng LSD radix: mảng khóa (đã đổi sang số không dấu) và mảng chỉ số được phân phối song song.
+// Giống RadixSort, Descending đảo toàn bộ bit của khóa nên các khóa bằng nhau vẫn giữ thứ tự ban đầu.
+template <typename Index, typename K>
+void orderByRadix(const K* keys, size_t n, Index* order, SortDirection direction) {
+    using Key = typename RadixSort<K>::Key;
+    if (n == 0)
+        return;
+    const Key flip = direction == SortDirection::Descending ? static_cast<Key>(~Key(0)) : Key(0);
+
+    std::pmr::vector<Key> bits(n);
+    std::array<std::array<size_t, 256>, sizeof(Key)> counts{};
+    for (size_t i = 0; i < n; ++i) {
+        bits[i] = RadixSort<K>::toKey(keys[i]) ^ flip;
+        order[i] = static_cast<Index>(i);
+        for (size_t d = 0; d < sizeof(Key); ++d)
+            ++counts[d][(bits[i] >> (8 * d)) & 0xFF];
+    }
+
+    std::pmr::vector<Key> bitsScratch;
+    std::pmr::vector<Index> orderScratch;
+    Key* srcBits = bits.data();
+    Index* srcOrder = order;
+    for (size_t d = 0; d < sizeof(Key); ++d) {
+        std::array<size_t, 256>& count = counts[d];
+        if (count[(srcBits[0] >> (8 * d)) & 0xFF] == n)
+            continue; // mọi khóa có cùng byte này
+        if (bitsScratch.empty()) {
+            bitsScratch.resize(n);
+            orderScratch.resize(n);
+        }
+        Key* dstBits = srcBits == bits.data() ? bitsScratch.data() : bits.data();
+        Index* dstOrder = srcOrder == order ? orderScratch.data() : order;
+
+        size_t offset = 0;
+        for (size_t& c : count) {
+            size_t bucket = c;
+            c = offset;
+            offset += bucket;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            size_t slot = count[(srcBits[i] >> (8 * d)) & 0xFF]++;
+            dstBits[slot] = srcBits[i];
+            dstOrder[slot] = srcOrder[i];
+        }
+        srcBits = dstBits;
+        srcOrder = dstOrder;
+    }
+    if (srcOrder != order)
+        std::copy(srcOrder, srcOrder + n, order);
+}
+
+// Sắp xếp lại các mảng theo hoán vị order (arrays[i] mới = arrays[order[i]] cũ) bằng cách đi theo từng chu trình:
+// mỗi phần tử chỉ bị di chuyển một lần và không cần mảng tạm cỡ n. order bị ghi đè thành hoán vị đơn vị.
+template <typename Index, typename... Arrays>
+void applyPermutation(Index* order, size_t n, Arrays*... arrays) {
+    for (size_t i = 0; i < n; ++i) {
+        if (order[i] == i)
+            continue;
+        auto saved = std::make_tuple(std::move(arrays[i])...);
+        size_t j = i;
+        while (static_cast<size_t>(order[j]) != i) {
+            size_t k = order[j];
+            ((arrays[j] = std::move(arrays[k])), ...);
+            order[j] = static_cast<Index>(j);
+            j = k;
+        }
+        std::apply([&](auto&... value) { ((arrays[j] = std::move(value)), ...); }, saved);
+        order[j] = static_cast<Index>(j);
+    }
+}
+
+// Gọi f với kiểu chỉ số nhỏ nhất đủ chứa n phần tử: uint32_t giảm một nửa băng thông so với uint64_t
+template <typename F>
+void withIndexType(size_t n, F&& f) {
+    if (n <= std::numeric_limits<uint32_t>::max())
+        f(uint32_t());
+    else
+        f(uint64_t());
+}
+
+} // namespace key_value_detail
+
+// Trả về hoán vị order sao cho keys[order[0]], keys[order[1]]... đã được sắp xếp; keys không bị thay đổi.
+// Index là uint32_t (mặc định) hoặc uint64_t, n phải không vượt quá giá trị lớn nhất của Index.
+template <typename Index = uint32_t, typename T, typename Cmp = DirectionOrder<T>>
+std::vector<Index> argsort(const T* keys, size_t n, Cmp comp = Cmp(), KeyValueAlgorithm algorithm = KeyValueAlgorithm::Merge) {
+    static_assert(std::is_unsigned<Index>::value, "argsort index must be an unsigned integer type");
+    if (n > 0 && n - 1 > std::numeric_limits<Index>::max())
+        throw std::length_error("argsort: too many elements for the index type");
+    std::vector<Index> order(n);
+    if (algorithm == KeyValueAlgorithm::Radix) {
+        if constexpr (std::is_arithmetic<T>::value && !std::is_same<T, bool>::value &&
+                      (std::is_same<Cmp, SortDirection>::value || std::is_same<Cmp, DirectionOrder<T>>::value)) {
+            key_value_detail::orderByRadix(keys, n, order.data(), DirectionOrder<T>(comp).direction);
+            return order;
+        } else {
+            throw std::invalid_argument("argsort: radix requires arithmetic keys ordered by SortDirection");
+        }
+    }
+    sort_engine::withOrder<T>(comp, [&](auto cmp) {
+        key_value_detail::orderByComparison(keys, n, order.data(), cmp, algorithm == KeyValueAlgorithm::Merge,
+                                            static_cast<T*>(nullptr));
+    });
+    return order;
+}
+
+template <typename Index = uint32_t, typename T, typename Cmp = DirectionOrder<T>>
+std::vector<Index> argsort(const std::vector<T>& keys, Cmp comp = Cmp(), KeyValueAlgorithm algorithm = KeyValueAlgorithm::Merge) {
+    return argsort<Index>(keys.data(), keys.size(), comp, algorithm);
+}
+
+// Lớp cơ sở cho sắp xếp khóa / payload: data của BasicSort là mảng khóa, values là mảng payload cùng kích thước
+template <typename K, typename V, typename Compare = DirectionOrder<K>>
+class KeyValueSort : public BasicSort<K, Compare> {
+public:
+    KeyValueSort(K* keys, V* values, size_t sz, Compare cmp = Compare())
+        : BasicSort<K, Compare>(keys, sz, cmp), values(values) {}
+
+    KeyValueSort(std::vector<K>& keys, std::vector<V>& values, Compare cmp = Compare())
+        : BasicSort<K, Compare>(keys, cmp), values(values.data()) {
+        if (keys.size() != values.size())
+            throw std::invalid_argument("KeyValueSort: keys and values must have the same size");
+    }
+
+protected:
+    // Sắp xếp bằng so sánh: khóa đã sắp xếp được ghi thẳng từ mảng cặp, chỉ payload cần đi theo hoán vị
+    void sortByComparison(bool stable) {
+        const size_t n = this->size;
+        if (n < 2)
+            return;
+        key_value_detail::withIndexType(n, [&](auto indexTag) {
+            using Index = decltype(indexTag);
+            std::vector<Index> order(n);
+            this->withComparator([&](auto comp) {
+                key_value_detail::orderByComparison(std::make_move_iterator(this->data), n, order.data(), comp, stable,
+                                                    this->data);
+            });
+            key_value_detail::applyPermutation(order.data(), n, values);
+        });
+    }
+
+    V* values;
+};
+
+// Quick Sort theo khóa: nhanh nhất với khóa bất kì, không giữ thứ tự của các khóa bằng nhau
+template <typename K, typename V, typename Compare = DirectionOrder<K>>
+class KeyValueQuickSort : public KeyValueSort<K, V, Compare> {
+public:
+    using KeyValueSort<K, V, Compare>::KeyValueSort;
+
+    void sort() override { this->sortByComparison(false); }
+};
+
+// Merge Sort theo khóa: ổn định, các phần tử có khóa bằng nhau giữ nguyên thứ tự ban đầu
+template <typename K, typename V, typename Compare = DirectionOrder<K>>
+class KeyValueMergeSort : public KeyValueSort<K, V, Compare> {
+public:
+    using KeyValueSort<K, V, Compare>::KeyValueSort;
+
+    void sort() override { this->sortByComparison(true); }
+};
+
+// Radix Sort theo khóa số (số nguyên, float, double): ổn định, O(n) cho mỗi byte của khóa
+template <typename K, typename V>
+class KeyValueRadixSort : public KeyValueSort<K, V> {
+    static_assert(std::is_arithmetic<K>::value && !std::is_same<K, bool>::value && sizeof(K) <= 8,
+                  "KeyValueRadixSort hỗ trợ khóa số nguyên và float/double");
+
+public:
+    using KeyValueSort<K, V>::KeyValueSort;
+
+    void sort() override {
+        const size_t n = this->size;
+        if (n < 2)
+            return;
+        key_value_detail::withIndexType(n, [&](auto indexTag) {
+            using Index = decltype(indexTag);
+            std::vector<Index> order(n);
+            key_value_detail::orderByRadix(this->data, n, order.data(), this->direction);
+            key_value_detail::applyPermutation(order.data(), n, this->data, this->values);
+        });
+    }
+};
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef _C_PLUS_PLUS_LAZY_SORT_ALGORIHMS_
+#define _C_PLUS_PLUS_LAZY_SORT_ALGORIHMS_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "C_Plus_Plus_Data_Structure_Algorihms.h"
+
+// ----------------------------------------------------------------- Lazy Sort -----------------------------------------------------------------
+// Sắp xếp lười (incremental quicksort, Paredes & Navarro): các phần tử được đưa ra theo thứ tự khi được đọc tới,
+// không phải chờ sắp xếp xong cả mảng. Chỉ đoạn chưa ổn định ngay sau vị trí đang đọc được phân hoạch (cùng pivot và
+// fat partition với QuickSort), phần bên phải pivot được để nguyên; vị trí của các pivot đang chờ nằm trong một stack.
+// Phần tử đầu tiên có sau O(n), k phần tử đầu tốn O(n + k log k), đọc hết thì tổng chi phí bằng một lần sắp xếp.
+// Mảng gốc bị hoán vị tại chỗ: các phần tử đã đọc qua đứng đúng vị trí cuối cùng và không bị di chuyển nữa.
+// VD: LazySort<float> lazy(vec, SortDirection::Ascending);
+//     for (float x : lazy) { if (done(x)) break; }   // dừng sớm thì phần còn lại không bị sắp xếp
+template <typename T, typename Compare = DirectionOrder<T>>
+class LazySort : public BasicSort<T, Compare> {
+public:
+    // Forward iterator: mỗi lần tăng chỉ sắp xếp thêm tới vị trí mới, các iterator khác vẫn dùng được
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        iterator() = default;
+
+        reference operator*() const { return owner->data[index]; }
+        pointer operator->() const { return owner->data + index; }
+
+        iterator& operator++() {
+            if (++index < owner->size)
+                owner->settle(index);
+            return *this;
+        }
+
+        iterator operator++(int) {
+            iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        // Số phần tử đã đọc qua, VD để biết đã lấy đủ k phần tử chưa
+        size_t position() const { return index; }
+
+        friend bool operator==(const iterator& a, const iterator& b) { return a.index == b.index; }
+        friend bool operator!=(const iterator& a, const iterator& b) { return a.index != b.index; }
+
+    private:
+        friend class LazySort;
+        iterator(LazySort* owner, size_t index) : owner(owner), index(index) {}
+
+        LazySort* owner = nullptr;
+        size_t index = 0;
+    };
+
+    LazySort(T* arr, size_t sz, Compare cmp = Compare()) : BasicSort<T, Compare>(arr, sz, cmp) { reset(); }
+
+    LazySort(std::vector<T>& vec, Compare cmp = Compare()) : BasicSort<T, Compare>(vec, cmp) { reset(); }
+
+    // Che begin() / end() của BasicSort: duyệt theo thứ tự sắp xếp, mỗi phần tử được sắp xếp khi được đọc tới
+    iterator begin() {
+        if (this->size > 0)
+            settle(0);
+        return iterator(this, 0);
+    }
+
+    iterator end() { return iterator(this, this->size); }
+
+    // Phần tử thứ i theo thứ tự sắp xếp; sắp xếp thêm tới i nếu cần
+    const T& at(size_t i) {
+        if (i >= this->size)
+            throw std::out_of_range("LazySort::at: index out of range");
+        settle(i);
+        return this->data[i];
+    }
+
+    // Số phần tử đầu đã đứng đúng vị trí cuối cùng
+    size_t settledCount() const { return settled; }
+
+    // Sắp xếp nốt phần còn lại
+    void sort() override {
+        if (this->size > 0)
+            settle(this->size - 1);
+    }
+
+private:
+    // Đoạn [first, last) các phần tử bằng pivot, đã nằm đúng vị trí cuối cùng
+    struct Pivot {
+        size_t first;
+        size_t last;
+    };
+
+    void reset() {
+        settled = 0;
+        pending.assign(1, Pivot{this->size, this->size}); // lính canh: đoạn chưa ổn định đầu tiên là cả mảng
+        badAllowed = sort_engine::depthLimit(static_cast<std::ptrdiff_t>(this->size));
+    }
+
+    // Sắp xếp cho tới khi data[0..i] ổn định. Đoạn chưa ổn định luôn là [settled, pending.back().first)
+    void settle(size_t i) {
+        if (i < settled)
+            return;
+        this->withComparator([&](auto comp) {
+            T* d = this->data;
+            while (settled <= i) {
+                const Pivot next = pending.back();
+                const size_t n = next.first - settled;
+                if (n == 0) {
+                    settled = next.last;
+                    pending.pop_back();
+                } else if (static_cast<std::ptrdiff_t>(n) <= sort_engine::leafSize<T*>(comp)) {
+                    sort_engine::smallSort(d + settled, d + next.first, comp);
+                    settled = next.first;
+                } else if (badAllowed <= 0) {
+                    // Quá nhiều lần phân hoạch lệch (dữ liệu xấu): sắp xếp hẳn cả đoạn, giữ chặn trên O(n log n)
+                    sort_engine::introSort(d + settled, d + next.first, sort_engine::depthLimit(n), comp);
+                    settled = next.first;
+                } else {
+                    pending.push_back(partition(d + settled, d + next.first, comp));
+                }
+            }
+        });
+    }
+
+    // Phân hoạch [first, last) như QuickSort: khóa số với thứ tự mặc định dùng phân hoạch theo khối không rẽ nhánh,
+    // các trường hợp khác dùng fat partition. Trả về đoạn các phần tử đã nằm đúng vị trí cuối cùng
+    template <typename Cmp>
+    Pivot partition(T* first, T* last, Cmp comp) {
+        T* d = this->data;
+        sort_engine::selectPivot(first, last, comp);
+        std::pair<T*, T*> equal;
+        if constexpr (sort_engine::BlockPartitionOrder<Cmp>::value) {
+            // Phần tử ngay trước đoạn (đã ổn định) bằng pivot: các phần tử bằng pivot là nhỏ nhất, được gom sang trái
+            // và ổn định luôn, không tính là phân hoạch lệch
+            if (first != d && !comp(first[-1], *first))
+                return Pivot{static_cast<size_t>(first - d), static_cast<size_t>(sort_engine::partitionLeft(first, last, comp) - d) + 1};
+            T* pivot = sort_engine::blockPartition(first, last, comp).first;
+            equal = {pivot, pivot + 1};
+        } else {
+            equal = sort_engine::fatPartition(first, last, comp);
+        }
+        // Lệch (phía nhỏ hơn dưới 1/8 đoạn) thì lần phân hoạch tiếp theo gần như lặp lại toàn bộ công việc
+        if (std::min(equal.first - first, last - equal.second) < (last - first) / 8)
+            --badAllowed;
+        return Pivot{static_cast<size_t>(equal.first - d), static_cast<size_t>(equal.second - d)};
+    }
+
+    size_t settled = 0;
+    std::vector<Pivot> pending;
+    int badAllowed = 0;
+};
+
+#endif
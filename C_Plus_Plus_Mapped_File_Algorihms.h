@@ -0,0 +1,204 @@
+#ifndef _C_PLUS_PLUS_MAPPED_FILE_ALGORIHMS_
+#define _C_PLUS_PLUS_MAPPED_FILE_ALGORIHMS_
+
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "C_Plus_Plus_Data_Structure_Algorihms.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// ----------------------------------------------------------------- Mapped File -----------------------------------------------------------------
+// Ánh xạ một file nhị phân chứa các phần tử T (ghi liên tiếp, không header) vào bộ nhớ để sắp xếp tại chỗ,
+// không phải đọc file vào vector rồi ghi lại (tránh gấp đôi bộ nhớ và một lần sao chép toàn bộ dữ liệu).
+// Dùng cho file vừa với RAM; file lớn hơn RAM hãy dùng ExternalSort.
+
+// Gợi ý cho hệ điều hành về cách thuật toán sẽ truy cập vùng nhớ (madvise)
+enum class AccessPattern {
+    Normal,
+    Sequential,  // đọc trước mạnh, trang đã dùng có thể bị giải phóng sớm
+    Random,      // tắt đọc trước
+    WillNeed     // nạp trước toàn bộ vùng nhớ
+};
+
+template <typename T>
+class MappedFile {
+    static_assert(std::is_trivially_copyable<T>::value, "MappedFile reinterprets raw bytes of the file as T");
+
+public:
+    explicit MappedFile(const std::string& path, bool writable = true) : writable(writable) {
+        map(path);
+    }
+
+    ~MappedFile() { unmap(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    T* data() const { return static_cast<T*>(address); }
+    size_t size() const { return count; }
+
+    // Không làm gì trên Windows, nơi không có madvise tương đương
+    void advise(AccessPattern pattern) const {
+#if !defined(_WIN32)
+        if (address == nullptr)
+            return;
+        int advice = MADV_NORMAL;
+        switch (pattern) {
+        case AccessPattern::Normal:     advice = MADV_NORMAL; break;
+        case AccessPattern::Sequential: advice = MADV_SEQUENTIAL; break;
+        case AccessPattern::Random:     advice = MADV_RANDOM; break;
+        case AccessPattern::WillNeed:   advice = MADV_WILLNEED; break;
+        }
+        // madvise chỉ là gợi ý, lỗi không ảnh hưởng tới kết quả nên được bỏ qua
+        ::madvise(address, bytes, advice);
+#else
+        (void)pattern;
+#endif
+    }
+
+    // Ghi các trang đã thay đổi xuống đĩa và chờ hoàn tất
+    void sync() const {
+        if (address == nullptr || !writable)
+            return;
+#if defined(_WIN32)
+        if (!FlushViewOfFile(address, 0) || !FlushFileBuffers(file))
+            throw std::runtime_error("MappedFile: flush failed");
+#else
+        if (::msync(address, bytes, MS_SYNC) != 0)
+            throw std::runtime_error("MappedFile: msync failed");
+#endif
+    }
+
+private:
+#if defined(_WIN32)
+    void map(const std::string& path) {
+        file = CreateFileA(path.c_str(), writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            throw std::runtime_error("MappedFile: cannot open " + path);
+        LARGE_INTEGER length;
+        if (!GetFileSizeEx(file, &length)) {
+            unmap();
+            throw std::runtime_error("MappedFile: cannot stat " + path);
+        }
+        setSize(static_cast<uint64_t>(length.QuadPart));
+        if (bytes == 0)
+            return;
+        mapping = CreateFileMappingA(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+        address = mapping ? MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0) : nullptr;
+        if (address == nullptr) {
+            unmap();
+            throw std::runtime_error("MappedFile: cannot map " + path);
+        }
+    }
+
+    void unmap() {
+        if (address != nullptr)
+            UnmapViewOfFile(address);
+        if (mapping != nullptr)
+            CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE)
+            CloseHandle(file);
+        address = nullptr;
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+    }
+
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    void map(const std::string& path) {
+        fd = ::open(path.c_str(), writable ? O_RDWR : O_RDONLY);
+        if (fd < 0)
+            throw std::runtime_error("MappedFile: cannot open " + path);
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            unmap();
+            throw std::runtime_error("MappedFile: cannot stat " + path);
+        }
+        setSize(static_cast<uint64_t>(info.st_size));
+        if (bytes == 0)
+            return;
+        // MAP_SHARED: thay đổi được ghi thẳng vào page cache của file, không tạo bản sao
+        void* mapped = ::mmap(nullptr, bytes, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED) {
+            unmap();
+            throw std::runtime_error("MappedFile: cannot map " + path);
+        }
+        address = mapped;
+    }
+
+    void unmap() {
+        if (address != nullptr)
+            ::munmap(address, bytes);
+        if (fd >= 0)
+            ::close(fd);
+        address = nullptr;
+        fd = -1;
+    }
+
+    int fd = -1;
+#endif
+
+    void setSize(uint64_t fileBytes) {
+        if (fileBytes % sizeof(T) != 0) {
+            unmap();
+            throw std::runtime_error("MappedFile: file size is not a multiple of the element size");
+        }
+        bytes = static_cast<size_t>(fileBytes);
+        count = bytes / sizeof(T);
+    }
+
+    bool writable;
+    void* address = nullptr;
+    size_t bytes = 0;
+    size_t count = 0;
+};
+
+// Kiểu truy cập chính của từng thuật toán: QuickSort phân hoạch nhảy giữa hai đầu đoạn và đệ quy vào các đoạn con
+// rải rác; MergeSort và RadixSort đọc/ghi dữ liệu theo từng lượt tuần tự
+template <typename Sorter>
+struct MappedAccess { static constexpr AccessPattern pattern = AccessPattern::Normal; };
+
+template <typename T, typename Compare>
+struct MappedAccess<QuickSort<T, Compare>> { static constexpr AccessPattern pattern = AccessPattern::Random; };
+
+template <typename T, typename Compare>
+struct MappedAccess<ParallelQuickSort<T, Compare>> { static constexpr AccessPattern pattern = AccessPattern::Random; };
+
+template <typename T, typename Compare>
+struct MappedAccess<MergeSort<T, Compare>> { static constexpr AccessPattern pattern = AccessPattern::Sequential; };
+
+template <typename T, typename Compare>
+struct MappedAccess<ParallelMergeSort<T, Compare>> { static constexpr AccessPattern pattern = AccessPattern::Sequential; };
+
+template <typename T>
+struct MappedAccess<RadixSort<T>> { static constexpr AccessPattern pattern = AccessPattern::Sequential; };
+
+// Ánh xạ file, sắp xếp tại chỗ bằng Sorter (qua con trỏ data của BasicSort) rồi msync.
+// Các tham số sau path được truyền cho constructor của Sorter sau (data, size).
+// VD: sortMappedFile<QuickSort<float>>("data.bin", SortDirection::Descending);
+//     sortMappedFile<ParallelMergeSort<int64_t>>("ids.bin", SortDirection::Ascending, 8);
+template <typename Sorter, typename... Args>
+void sortMappedFile(const std::string& path, Args&&... args) {
+    using T = typename Sorter::value_type;
+    MappedFile<T> file(path);
+    // File vừa RAM sẽ bị đọc toàn bộ: nạp trước các trang, sau đó đặt gợi ý theo kiểu truy cập của thuật toán
+    file.advise(AccessPattern::WillNeed);
+    file.advise(MappedAccess<Sorter>::pattern);
+    Sorter sorter(file.data(), file.size(), std::forward<Args>(args)...);
+    sorter.sort();
+    file.sync();
+}
+
+#endif
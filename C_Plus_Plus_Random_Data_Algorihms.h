@@ -4,36 +4,321 @@
 #include <iostream>
 #include <vector>
 #include <random>
+#include <memory>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include "C_Plus_Plus_Thread_Pool_Algorihms.h"
+#include "C_Plus_Plus_Sort_Arena_Algorihms.h"
 
+// Các kiểu phân bố dữ liệu đầu vào, dùng để sinh dữ liệu test và benchmark
+enum class Distribution {
+    Uniform,      // ngẫu nhiên đều trong [minVal, maxVal]
+    Sorted,       // tăng dần đều từ minVal tới maxVal
+    Reversed,     // giảm dần đều từ maxVal tới minVal
+    NearlySorted, // tăng dần rồi hoán đổi ngẫu nhiên một tỉ lệ nhỏ các cặp phần tử
+    FewUnique,    // chỉ có một số ít giá trị khác nhau
+    OrganPipe,    // nửa đầu tăng dần, nửa sau giảm dần
+    Zipf,         // giá trị thứ k xuất hiện với tần suất tỉ lệ 1/k^s (giá trị nhỏ xuất hiện nhiều)
+    Sawtooth,     // lặp lại nhiều đoạn tăng dần
+    SignedZeros   // ngẫu nhiên đều, rải thêm khoảng 16 số 0 (số thực: -0.0 hoặc +0.0, bằng nhau nhưng khác bit)
+};
+
+inline const char* distributionName(Distribution distribution) {
+    switch (distribution) {
+    case Distribution::Uniform:      return "uniform";
+    case Distribution::Sorted:       return "sorted";
+    case Distribution::Reversed:     return "reversed";
+    case Distribution::NearlySorted: return "nearly_sorted";
+    case Distribution::FewUnique:    return "few_unique";
+    case Distribution::OrganPipe:    return "organ_pipe";
+    case Distribution::Zipf:         return "zipf";
+    case Distribution::Sawtooth:     return "sawtooth";
+    case Distribution::SignedZeros:  return "signed_zeros";
+    }
+    return "unknown";
+}
+
+inline const std::vector<Distribution>& allDistributions() {
+    static const std::vector<Distribution> all{
+        Distribution::Uniform, Distribution::Sorted, Distribution::Reversed, Distribution::NearlySorted,
+        Distribution::FewUnique, Distribution::OrganPipe, Distribution::Zipf, Distribution::Sawtooth,
+        Distribution::SignedZeros};
+    return all;
+}
+
+// Tham số phụ của các phân bố, giá trị mặc định phù hợp cho benchmark
+struct DistributionParams {
+    double swapFraction = 0.01;   // NearlySorted: số cặp bị hoán đổi = swapFraction * size
+    size_t distinctValues = 16;   // FewUnique: số giá trị khác nhau
+    double zipfExponent = 1.0;    // Zipf: số mũ s
+    size_t zipfUniverse = 0;      // Zipf: số giá trị khác nhau có thể xuất hiện, 0 = size
+    size_t sawtoothPeriod = 0;    // Sawtooth: độ dài mỗi đoạn tăng, 0 = size / 16
+};
+
+// PRNG dựa trên bộ đếm (SplitMix64): số thứ i chỉ phụ thuộc vào (seed, i) nên có thể sinh song song theo từng khối
+// mà kết quả vẫn giống hệt khi sinh tuần tự, không phụ thuộc số luồng.
+class CounterRandom {
+public:
+    explicit CounterRandom(uint64_t seed, uint64_t stream = 0) : key(mix(seed ^ mix(stream + 0x632BE59BD9B4E019ULL))) {}
+
+    uint64_t operator()(uint64_t counter) const { return mix(key + (counter + 1) * 0x9E3779B97F4A7C15ULL); }
+
+    // Số thực đều trong [0, 1) với 53 bit ngẫu nhiên
+    double unit(uint64_t counter) const { return static_cast<double>((*this)(counter) >> 11) * 0x1.0p-53; }
+
+    // Số nguyên đều trong [0, bound), bound > 0
+    uint64_t below(uint64_t counter, uint64_t bound) const {
+#if defined(__SIZEOF_INT128__)
+        return static_cast<uint64_t>((static_cast<unsigned __int128>((*this)(counter)) * bound) >> 64);
+#else
+        return (*this)(counter) % bound;
+#endif
+    }
+
+private:
+    static uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t key;
+};
+
+// Sinh số nguyên 1..universe theo phân bố Zipf bằng phương pháp rejection-inversion (Hörmann & Derflinger),
+// mỗi mẫu chỉ tốn O(1) và không cần bảng CDF kích thước universe
+class ZipfSampler {
+public:
+    ZipfSampler(uint64_t universe, double exponent) : universe(std::max<uint64_t>(universe, 1)), exponent(exponent) {
+        if (!(exponent > 0))
+            throw std::invalid_argument("ZipfSampler: exponent must be positive");
+        hIntegralX1 = hIntegral(1.5) - 1.0;
+        hIntegralN = hIntegral(static_cast<double>(this->universe) + 0.5);
+        s = 2.0 - hIntegralInverse(hIntegral(2.5) - h(2.0));
+    }
+
+    // uniform(attempt) trả về số thực đều trong [0, 1) cho lần thử thứ attempt
+    template <typename Uniform>
+    uint64_t sample(Uniform uniform) const {
+        for (uint64_t attempt = 0;; ++attempt) {
+            double u = hIntegralN + uniform(attempt) * (hIntegralX1 - hIntegralN);
+            double x = hIntegralInverse(u);
+            double k = std::floor(x + 0.5);
+            k = std::min(std::max(k, 1.0), static_cast<double>(universe));
+            if (k - x <= s || u >= hIntegral(k + 0.5) - h(k))
+                return static_cast<uint64_t>(k);
+        }
+    }
+
+private:
+    double h(double x) const { return std::exp(-exponent * std::log(x)); }
+
+    double hIntegral(double x) const {
+        double logX = std::log(x);
+        return helper2((1.0 - exponent) * logX) * logX;
+    }
+
+    double hIntegralInverse(double x) const {
+        double t = std::max(x * (1.0 - exponent), -1.0);
+        return std::exp(helper1(t) * x);
+    }
+
+    // log1p(x) / x và expm1(x) / x, ổn định khi x gần 0
+    static double helper1(double x) { return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x)); }
+    static double helper2(double x) { return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x)); }
+
+    uint64_t universe;
+    double exponent;
+    double hIntegralX1;
+    double hIntegralN;
+    double s;
+};
+
+// Sinh dữ liệu ngẫu nhiên cho số nguyên và số thực. Cùng seed luôn cho cùng dữ liệu, bất kể số luồng.
+// Dữ liệu được trả về qua container sở hữu bộ nhớ (std::vector hoặc std::unique_ptr<T[]>) nên không cần delete[].
 template <typename T>
 class RandomGenerator {
+    static_assert(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value,
+                  "RandomGenerator supports integral and floating-point types");
+
 public:
-    // Hàm tạo mảng ngẫu nhiên
-    T* generateRandomArray(size_t size, T minVal, T maxVal) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_real_distribution<T> distrib(minVal, maxVal); // Dùng uniform_real_distribution cho kiểu float
+    // seed mặc định lấy từ std::random_device; threads = 0 dùng hardware_concurrency()
+    explicit RandomGenerator(uint64_t seed = std::random_device()(), size_t threads = 0) : seedValue(seed), threads(threads) {}
 
-        // Cấp phát bộ nhớ cho mảng động
-        T* arr = new T[size];
-        for (size_t i = 0; i < size; ++i) {
-            arr[i] = distrib(gen);
-        }
-        return arr;
+    uint64_t seed() const { return seedValue; }
+
+    // Hàm tạo mảng ngẫu nhiên
+    std::unique_ptr<T[]> generateRandomArray(size_t size, T minVal, T maxVal) {
+        return generateArray(Distribution::Uniform, size, minVal, maxVal);
     }
 
     // Hàm tạo vector ngẫu nhiên
     std::vector<T> generateRandomVector(size_t size, T minVal, T maxVal) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_real_distribution<T> distrib(minVal, maxVal);
+        return generateVector(Distribution::Uniform, size, minVal, maxVal);
+    }
+
+    std::unique_ptr<T[]> generateArray(Distribution distribution, size_t size, T minVal, T maxVal,
+                                       const DistributionParams& params = DistributionParams()) {
+        std::unique_ptr<T[]> arr(new T[size]);
+        fill(arr.get(), size, distribution, minVal, maxVal, params);
+        return arr;
+    }
 
+    std::vector<T> generateVector(Distribution distribution, size_t size, T minVal, T maxVal,
+                                  const DistributionParams& params = DistributionParams()) {
         std::vector<T> vec(size);
-        for (size_t i = 0; i < size; ++i) {
-            vec[i] = distrib(gen);
-        }
+        fill(vec.data(), size, distribution, minVal, maxVal, params);
         return vec;
     }
+
+    // Như generateArray nhưng trên huge page; các khối được sinh song song nên với FirstTouch mỗi trang nằm ở node
+    // của luồng đã sinh ra nó. Dùng cho mảng hàng tỉ phần tử
+    HugePageBuffer<T> generateHugePageArray(Distribution distribution, size_t size, T minVal, T maxVal,
+                                            const DistributionParams& params = DistributionParams(),
+                                            NumaPlacement placement = NumaPlacement::FirstTouch) {
+        HugePageBuffer<T> buffer(size, placement);
+        fill(buffer.data(), size, distribution, minVal, maxVal, params);
+        return buffer;
+    }
+
+    // Ghi size phần tử theo phân bố distribution vào out, giá trị nằm trong [minVal, maxVal]
+    void fill(T* out, size_t size, Distribution distribution, T minVal, T maxVal,
+              const DistributionParams& params = DistributionParams()) {
+        if (maxVal < minVal)
+            throw std::invalid_argument("RandomGenerator: minVal must not exceed maxVal");
+        if (size == 0)
+            return;
+        const Range range(minVal, maxVal);
+        const CounterRandom random(seedValue);
+        const double last = size > 1 ? static_cast<double>(size - 1) : 1.0;
+
+        switch (distribution) {
+        case Distribution::Uniform:
+            parallelFill(out, size, [&](size_t i) { return range.uniform(random(i)); });
+            break;
+        case Distribution::Sorted:
+            parallelFill(out, size, [&](size_t i) { return range.at(i / last); });
+            break;
+        case Distribution::Reversed:
+            parallelFill(out, size, [&](size_t i) { return range.at((size - 1 - i) / last); });
+            break;
+        case Distribution::NearlySorted: {
+            parallelFill(out, size, [&](size_t i) { return range.at(i / last); });
+            // Số lần hoán đổi nhỏ so với size nên làm tuần tự, giữ kết quả tái lập được
+            const CounterRandom swaps(seedValue, 1);
+            const size_t count = static_cast<size_t>(params.swapFraction * size);
+            for (size_t k = 0; k < count; ++k)
+                std::swap(out[swaps.below(2 * k, size)], out[swaps.below(2 * k + 1, size)]);
+            break;
+        }
+        case Distribution::FewUnique: {
+            const size_t distinct = std::max<size_t>(params.distinctValues, 1);
+            const double step = distinct > 1 ? static_cast<double>(distinct - 1) : 1.0;
+            parallelFill(out, size, [&](size_t i) { return range.at(random.below(i, distinct) / step); });
+            break;
+        }
+        case Distribution::OrganPipe: {
+            const double half = std::max<double>(static_cast<double>(size / 2), 1.0);
+            parallelFill(out, size, [&](size_t i) { return range.at(std::min(i, size - 1 - i) / half); });
+            break;
+        }
+        case Distribution::Zipf: {
+            const uint64_t universe = params.zipfUniverse != 0 ? params.zipfUniverse : size;
+            const ZipfSampler sampler(universe, params.zipfExponent);
+            const double step = universe > 1 ? static_cast<double>(universe - 1) : 1.0;
+            parallelFill(out, size, [&](size_t i) {
+                // Mỗi phần tử dùng một luồng số riêng cho các lần thử bị loại, để vẫn tái lập được khi sinh song song
+                uint64_t k = sampler.sample([&](uint64_t attempt) { return random.unit(i + attempt * size); });
+                return range.at((k - 1) / step);
+            });
+            break;
+        }
+        case Distribution::Sawtooth: {
+            const size_t period = std::max<size_t>(params.sawtoothPeriod != 0 ? params.sawtoothPeriod : size / 16, 2);
+            parallelFill(out, size, [&](size_t i) { return range.at((i % period) / static_cast<double>(period - 1)); });
+            break;
+        }
+        case Distribution::SignedZeros: {
+            // 0 bị chặn vào [minVal, maxVal]; với số nguyên -0 chính là 0. Số lượng số 0 không phụ thuộc size và nhỏ hơn
+            // một đoạn lá của quicksort, để chúng nằm lẫn với các giá trị khác trong mạng sắp xếp thay vì bị gom hết vào
+            // đoạn bằng pivot
+            const T zero = std::min(maxVal, std::max(minVal, T(0)));
+            const T negativeZero = zero == T(0) ? static_cast<T>(-zero) : zero;
+            parallelFill(out, size, [&](size_t i) {
+                if (random.below(i, size) >= 16)
+                    return range.uniform(random(i + size));
+                return random.below(i + size, 2) == 0 ? zero : negativeZero;
+            });
+            break;
+        }
+        }
+    }
+
+private:
+    // Khoảng giá trị [minVal, maxVal]: at(u) ánh xạ đơn điệu u ∈ [0, 1] vào khoảng, uniform(bits) lấy giá trị đều
+    struct Range {
+        T minVal;
+        T maxVal;
+
+        Range(T minVal, T maxVal) : minVal(minVal), maxVal(maxVal) {}
+
+        T at(double u) const {
+            if constexpr (std::is_floating_point<T>::value) {
+                return std::min(maxVal, static_cast<T>(minVal + (static_cast<double>(maxVal) - minVal) * u));
+            } else {
+                const uint64_t width = span();
+                const double offset = u * static_cast<double>(width);
+                // 2^64 không biểu diễn được bằng uint64_t nên phải chặn trước khi ép kiểu
+                const uint64_t step = offset >= 18446744073709551615.0 ? width : std::min(width, static_cast<uint64_t>(offset));
+                return fromOffset(step);
+            }
+        }
+
+        T uniform(uint64_t bits) const {
+            if constexpr (std::is_floating_point<T>::value) {
+                return at(static_cast<double>(bits >> 11) * 0x1.0p-53);
+            } else {
+                const uint64_t width = span();
+                if (width == std::numeric_limits<uint64_t>::max())
+                    return fromOffset(bits);
+#if defined(__SIZEOF_INT128__)
+                return fromOffset(static_cast<uint64_t>((static_cast<unsigned __int128>(bits) * (width + 1)) >> 64));
+#else
+                return fromOffset(bits % (width + 1));
+#endif
+            }
+        }
+
+        // maxVal - minVal tính trong số không dấu 64 bit để không tràn với kiểu có dấu
+        uint64_t span() const { return static_cast<uint64_t>(maxVal) - static_cast<uint64_t>(minVal); }
+        T fromOffset(uint64_t offset) const { return static_cast<T>(static_cast<uint64_t>(minVal) + offset); }
+    };
+
+    // Ghi out[i] = value(i) theo từng khối trên thread pool; mảng nhỏ được ghi tuần tự
+    template <typename ValueAt>
+    void parallelFill(T* out, size_t size, ValueAt value) {
+        const size_t block = size_t(1) << 16;
+        const size_t blocks = (size + block - 1) / block;
+        auto fillBlock = [&](size_t b) {
+            const size_t end = std::min(size, (b + 1) * block);
+            for (size_t i = b * block; i < end; ++i)
+                out[i] = value(i);
+        };
+        if (blocks <= 1 || threads == 1) {
+            for (size_t b = 0; b < blocks; ++b)
+                fillBlock(b);
+            return;
+        }
+        WorkStealingPool pool(threads);
+        pool.parallelFor(blocks, fillBlock);
+    }
+
+    uint64_t seedValue;
+    size_t threads;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,412 @@
+#ifndef _C_PLUS_PLUS_SEARCH_INDEX_ALGORIHMS_
+#define _C_PLUS_PLUS_SEARCH_INDEX_ALGORIHMS_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "C_Plus_Plus_Data_Structure_Algorihms.h"
+
+// ----------------------------------------------------------------- Search Index -----------------------------------------------------------------
+// Chỉ mục chỉ đọc dựng từ một mảng đã sắp xếp (VD kết quả của QuickSort / MergeSort) để trả lời nhiều truy vấn:
+// lowerBound (hạng của phần tử đầu tiên không đứng trước x), contains và đếm số phần tử trong [lo, hi).
+// Tìm kiếm nhị phân trên mảng sắp xếp nhảy cách xa nhau ở các bước đầu nên gần như mỗi bước là một cache miss;
+// hai cách bố trí dưới đây gom các phần tử được đọc liên tiếp vào cùng cache line:
+//   - EytzingerIndex: cây nhị phân lưu theo thứ tự BFS, prefetch trước vài tầng (mọi hậu duệ cách 4 tầng
+//     của một nút nằm trên cùng một cache line)
+//   - StaticBTreeIndex: cây B+ tĩnh, mỗi nút là một cache line 64 byte, tìm trong nút bằng AVX2 với khóa số
+// Các API theo lô xử lí xen kẽ batchGroup truy vấn cùng lúc: mỗi tầng phát ra nhiều lần đọc bộ nhớ độc lập
+// nên độ trễ của chúng chồng lên nhau thay vì nối tiếp.
+// Chỉ mục giữ bản sao của dữ liệu, mảng nguồn có thể bị thay đổi hoặc giải phóng sau khi dựng.
+
+namespace search_index_detail {
+
+// Số phần tử trên một cache line 64 byte với kiểu số, 0 với các kiểu khác (không căn lề / prefetch theo dòng)
+template <typename T>
+constexpr size_t lineElements = std::is_arithmetic<T>::value && 64 % sizeof(T) == 0 ? 64 / sizeof(T) : 0;
+
+// Số truy vấn được xử lí xen kẽ trong các API theo lô
+constexpr size_t batchGroup = 16;
+
+inline void prefetch(const void* address) {
+#if defined(__GNUC__)
+    __builtin_prefetch(address);
+#else
+    (void)address;
+#endif
+}
+
+// Số bit 1 liên tiếp ở cuối k
+inline unsigned trailingOnes(size_t k) {
+#if defined(__GNUC__)
+    return static_cast<unsigned>(__builtin_ctzll(~static_cast<unsigned long long>(k)));
+#else
+    unsigned ones = 0;
+    for (; k & 1; k >>= 1)
+        ++ones;
+    return ones;
+#endif
+}
+
+// Vị trí bit 1 cao nhất của k (k > 0)
+inline unsigned highestBit(size_t k) {
+#if defined(__GNUC__)
+    return 63u - static_cast<unsigned>(__builtin_clzll(static_cast<unsigned long long>(k)));
+#else
+    unsigned bit = 0;
+    while (k >>= 1)
+        ++bit;
+    return bit;
+#endif
+}
+
+// Mảng có phần tử đầu nằm ở địa chỉ chia hết cho 64 (với kiểu số). Bản sao được căn lề lại trên vùng nhớ mới
+template <typename T>
+class AlignedArray {
+public:
+    explicit AlignedArray(size_t n = 0) : count(n), storage(n + lineElements<T>) {
+        if constexpr (lineElements<T> != 0) {
+            const size_t misalign = reinterpret_cast<std::uintptr_t>(storage.data()) % 64;
+            offset = misalign == 0 ? 0 : (64 - misalign) / sizeof(T);
+        }
+    }
+
+    AlignedArray(const AlignedArray& other) : AlignedArray(other.count) {
+        std::copy(other.data(), other.data() + count, data());
+    }
+
+    AlignedArray(AlignedArray&&) = default;
+
+    AlignedArray& operator=(AlignedArray other) {
+        std::swap(count, other.count);
+        std::swap(storage, other.storage);
+        std::swap(offset, other.offset);
+        return *this;
+    }
+
+    T* data() { return storage.data() + offset; }
+    const T* data() const { return storage.data() + offset; }
+
+private:
+    size_t count;
+    std::vector<T> storage;
+    size_t offset = 0;
+};
+
+template <typename T, typename Cmp>
+void requireSorted(const char* owner, const T* first, const T* last, Cmp order) {
+    if (!std::is_sorted(first, last, order))
+        throw std::invalid_argument(std::string(owner) + ": input is not sorted in the index order");
+}
+
+} // namespace search_index_detail
+
+// Cây nhị phân tìm kiếm đầy đủ lưu theo thứ tự BFS (bố cục Eytzinger): nút k có hai con 2k và 2k + 1, gốc là 1.
+// Vòng đi xuống không có nhánh phụ thuộc dữ liệu; hạng của kết quả được tính từ chỉ số nút bằng công thức
+// (không lưu thêm mảng hạng)
+template <typename T, typename Compare = DirectionOrder<T>>
+class EytzingerIndex {
+public:
+    EytzingerIndex(const T* first, const T* last, Compare cmp = Compare())
+        : comp(cmp), elements(static_cast<size_t>(last - first)), tree(elements + 1) {
+        sort_engine::withOrder<T>(comp, [&](auto order) { search_index_detail::requireSorted("EytzingerIndex", first, last, order); });
+        if (elements != 0)
+            height = search_index_detail::highestBit(elements);
+        size_t next = 0;
+        build(first, 1, next);
+    }
+
+    explicit EytzingerIndex(const std::vector<T>& sorted, Compare cmp = Compare())
+        : EytzingerIndex(sorted.data(), sorted.data() + sorted.size(), cmp) {}
+
+    // Dựng trên kết quả của một lớp sắp xếp (sau khi đã gọi sort()), dùng cùng bộ so sánh
+    explicit EytzingerIndex(const BasicSort<T, Compare>& sorted)
+        : EytzingerIndex(sorted.begin(), sorted.end(), sorted.comparator()) {}
+
+    size_t size() const { return elements; }
+
+    // Số phần tử đứng trước x theo thứ tự của chỉ mục, tức vị trí của std::lower_bound trên mảng gốc
+    size_t lowerBound(const T& x) const {
+        size_t rank = 0;
+        sort_engine::withOrder<T>(comp, [&](auto order) { rank = descend(x, order).rank; });
+        return rank;
+    }
+
+    bool contains(const T& x) const {
+        bool found = false;
+        sort_engine::withOrder<T>(comp, [&](auto order) {
+            const Probe probe = descend(x, order);
+            found = probe.node != 0 && !order(x, tree.data()[probe.node]);
+        });
+        return found;
+    }
+
+    // Số phần tử nằm trong [lo, hi) theo thứ tự của chỉ mục
+    size_t count(const T& lo, const T& hi) const {
+        const size_t begin = lowerBound(lo), end = lowerBound(hi);
+        return end > begin ? end - begin : 0;
+    }
+
+    // Các phiên bản theo lô: out[i] là kết quả của truy vấn thứ i
+    void lowerBound(const T* queries, size_t m, size_t* out) const {
+        sort_engine::withOrder<T>(comp, [&](auto order) {
+            batch(queries, m, order, [&](size_t i, const Probe& probe) { out[i] = probe.rank; });
+        });
+    }
+
+    void contains(const T* queries, size_t m, bool* out) const {
+        sort_engine::withOrder<T>(comp, [&](auto order) {
+            batch(queries, m, order, [&](size_t i, const Probe& probe) {
+                out[i] = probe.node != 0 && !order(queries[i], tree.data()[probe.node]);
+            });
+        });
+    }
+
+    void count(const T* lo, const T* hi, size_t m, size_t* out) const {
+        sort_engine::withOrder<T>(comp, [&](auto order) {
+            batch(lo, m, order, [&](size_t i, const Probe& probe) { out[i] = probe.rank; });
+            batch(hi, m, order, [&](size_t i, const Probe& probe) { out[i] = probe.rank > out[i] ? probe.rank - out[i] : 0; });
+        });
+    }
+
+private:
+    // Kết quả đi xuống: hạng của lower bound và nút chứa nó (0 nếu mọi phần tử đứng trước x)
+    struct Probe {
+        size_t rank;
+        size_t node;
+    };
+
+    static constexpr size_t lineElements = search_index_detail::lineElements<T>;
+
+    void build(const T* sorted, size_t k, size_t& next) {
+        if (k > elements)
+            return;
+        build(sorted, 2 * k, next);
+        tree.data()[k] = sorted[next++];
+        build(sorted, 2 * k + 1, next);
+    }
+
+    // Một bước đi xuống từ nút k. Prefetch cache line chứa các hậu duệ của k ở log2(lineElements) tầng bên dưới,
+    // để khi tới đó chúng đã nằm trong cache
+    template <typename Cmp>
+    void step(const T& x, Cmp order, size_t& k) const {
+        const T* b = tree.data();
+        if constexpr (lineElements != 0)
+            search_index_detail::prefetch(b + std::min(k * lineElements, elements));
+        k = 2 * k + order(b[k], x);
+    }
+
+    // Sau khi rơi khỏi cây, bỏ các bước rẽ phải cuối cùng và một bước rẽ trái để về nút của lower bound,
+    // rồi đổi nút sang hạng: vị trí trung tố của nút trong cây hoàn hảo cùng chiều cao, trừ đi số ô trống
+    // của tầng cuối đứng trước nó (các ô tầng cuối nằm ở vị trí chẵn 0, 2, 4... của thứ tự trung tố)
+    Probe settle(size_t k) const {
+        const unsigned shift = search_index_detail::trailingOnes(k) + 1;
+        const size_t node = shift >= sizeof(size_t) * 8 ? 0 : k >> shift;
+        if (node == 0)
+            return {elements, 0};
+        const unsigned depth = search_index_detail::highestBit(node);
+        const size_t position = ((2 * (node - (size_t(1) << depth)) + 1) << (height - depth)) - 1;
+        const size_t lastLevel = elements - (size_t(1) << height) + 1;   // số nút thật ở tầng cuối
+        const size_t before = (position + 1) / 2;                        // số ô tầng cuối đứng trước node
+        return {position - (before > lastLevel ? before - lastLevel : 0), node};
+    }
+
+    template <typename Cmp>
+    Probe descend(const T& x, Cmp order) const {
+        size_t k = 1;
+        while (k <= elements)
+            step(x, order, k);
+        return settle(k);
+    }
+
+    // Các truy vấn của một nhóm đi xuống cùng nhau từng tầng
+    template <typename Cmp, typename Sink>
+    void batch(const T* queries, size_t m, Cmp order, Sink sink) const {
+        constexpr size_t group = search_index_detail::batchGroup;
+        for (size_t start = 0; start < m; start += group) {
+            const size_t g = std::min(group, m - start);
+            size_t k[group];
+            std::fill_n(k, g, size_t(1));
+            for (unsigned level = 0; level <= height; ++level)
+                for (size_t j = 0; j < g; ++j)
+                    if (k[j] <= elements)
+                        step(queries[start + j], order, k[j]);
+            for (size_t j = 0; j < g; ++j)
+                sink(start + j, settle(k[j]));
+        }
+    }
+
+    Compare comp;
+    size_t elements;
+    unsigned height = 0;   // tầng sâu nhất của cây (gốc ở tầng 0)
+    search_index_detail::AlignedArray<T> tree;   // phần tử 0 không dùng
+};
+
+// Cây B+ tĩnh (S+ tree): tầng lá là chính mảng đã sắp xếp cắt thành các nút nodeKeys khóa (nút cuối lấp bằng khóa
+// lớn nhất); mỗi nút trong có nodeKeys khóa phân cách và nodeKeys + 1 con, khóa thứ i là khóa nhỏ nhất của con i + 1.
+// Vị trí con được tính bằng công thức (con của nút k là k * (nodeKeys + 1) + i) nên nút không chứa con trỏ,
+// một nút với float / int32 / int64 / double vừa đúng một cache line và được tìm bằng một lần so sánh AVX2.
+template <typename T, typename Compare = DirectionOrder<T>>
+class StaticBTreeIndex {
+public:
+    static constexpr size_t nodeKeys = search_index_detail::lineElements<T> != 0 ? search_index_detail::lineElements<T> : 16;
+
+    StaticBTreeIndex(const T* first, const T* last, Compare cmp = Compare())
+        : comp(cmp), elements(static_cast<size_t>(last - first)) {
+        sort_engine::withOrder<T>(comp, [&](auto order) { search_index_detail::requireSorted("StaticBTreeIndex", first, last, order); });
+        if (elements == 0)
+            return;
+        for (size_t nodes = (elements + nodeKeys - 1) / nodeKeys;; nodes = (nodes + nodeKeys) / (nodeKeys + 1)) {
+            layerNodes.push_back(nodes);
+            if (nodes == 1)
+                break;
+        }
+        size_t total = 0;
+        for (size_t nodes : layerNodes) {
+            layerStart.push_back(total);
+            total += nodes * nodeKeys;
+        }
+        keys = search_index_detail::AlignedArray<T>(total);
+        build(first);
+    }
+
+    explicit StaticBTreeIndex(const std::vector<T>& sorted, Compare cmp = Compare())
+        : StaticBTreeIndex(sorted.data(), sorted.data() + sorted.size(), cmp) {}
+
+    // Dựng trên kết quả của một lớp sắp xếp (sau khi đã gọi sort()), dùng cùng bộ so sánh
+    explicit StaticBTreeIndex(const BasicSort<T, Compare>& sorted)
+        : StaticBTreeIndex(sorted.begin(), sorted.end(), sorted.comparator()) {}
+
+    size_t size() const { return elements; }
+
+    // Số tầng của cây (tính cả tầng lá), cũng là số cache line phải đọc cho một truy vấn
+    size_t height() const { return layerNodes.size(); }
+
+    // Số phần tử đứng trước x theo thứ tự của chỉ mục, tức vị trí của std::lower_bound trên mảng gốc
+    size_t lowerBound(const T& x) const {
+        size_t rank = 0;
+        sort_engine::withOrder<T>(comp, [&](auto order) { rank = descend(x, order, simdNodeWidth<T>(order) == nodeKeys); });
+        return rank;
+    }
+
+    bool contains(const T& x) const {
+        bool found = false;
+        sort_engine::withOrder<T>(comp, [&](auto order) {
+            const size_t rank = descend(x, order, simdNodeWidth<T>(order) == nodeKeys);
+            found = rank < elements && !order(x, leaves()[rank]);
+        });
+        return found;
+    }
+
+    // Số phần tử nằm trong [lo, hi) theo thứ tự của chỉ mục
+    size_t count(const T& lo, const T& hi) const {
+        const size_t begin = lowerBound(lo), end = lowerBound(hi);
+        return end > begin ? end - begin : 0;
+    }
+
+    // Các phiên bản theo lô: out[i] là kết quả của truy vấn thứ i
+    void lowerBound(const T* queries, size_t m, size_t* out) const {
+        sort_engine::withOrder<T>(comp, [&](auto order) {
+            batch(queries, m, order, [&](size_t i, size_t rank) { out[i] = rank; });
+        });
+    }
+
+    void contains(const T* queries, size_t m, bool* out) const {
+        sort_engine::withOrder<T>(comp, [&](auto order) {
+            batch(queries, m, order, [&](size_t i, size_t rank) { out[i] = rank < elements && !order(queries[i], leaves()[rank]); });
+        });
+    }
+
+    void count(const T* lo, const T* hi, size_t m, size_t* out) const {
+        sort_engine::withOrder<T>(comp, [&](auto order) {
+            batch(lo, m, order, [&](size_t i, size_t rank) { out[i] = rank; });
+            batch(hi, m, order, [&](size_t i, size_t rank) { out[i] = rank > out[i] ? rank - out[i] : 0; });
+        });
+    }
+
+private:
+    const T* leaves() const { return keys.data(); }
+    const T* node(size_t layer, size_t k) const { return keys.data() + layerStart[layer] + k * nodeKeys; }
+
+    void build(const T* sorted) {
+        T* out = keys.data();
+        const T& largest = sorted[elements - 1];
+        for (size_t i = 0; i < layerNodes[0] * nodeKeys; ++i)
+            out[i] = i < elements ? sorted[i] : largest;
+        size_t leavesPerChild = 1;   // số nút lá dưới một nút của tầng layer - 1
+        for (size_t layer = 1; layer < layerNodes.size(); ++layer) {
+            T* layerKeys = out + layerStart[layer];
+            for (size_t k = 0; k < layerNodes[layer]; ++k)
+                for (size_t i = 0; i < nodeKeys; ++i) {
+                    const size_t child = k * (nodeKeys + 1) + i + 1;
+                    layerKeys[k * nodeKeys + i] = child < layerNodes[layer - 1] ? sorted[child * leavesPerChild * nodeKeys] : largest;
+                }
+            leavesPerChild *= nodeKeys + 1;
+        }
+    }
+
+    // Số khóa của nút đứng trước x, cũng là chỉ số của con cần đi xuống
+    template <typename Cmp>
+    static size_t nodeRank(const T* keys, const T& x, Cmp order, bool simd) {
+        if constexpr (SimdNodeSearch<T>::width == nodeKeys) {
+            if (simd)
+                return SimdNodeSearch<T>::rank(keys, x, std::is_same<Cmp, std::greater<T>>::value);
+        }
+        size_t rank = 0;
+        for (size_t i = 0; i < nodeKeys; ++i)
+            rank += order(keys[i], x);
+        return rank;
+    }
+
+    // x đứng sau khóa lớn nhất: khóa lấp chỗ trống cũng đứng trước x nên không được đi xuống (con có thể không tồn tại)
+    template <typename Cmp>
+    bool beyondLast(const T& x, Cmp order) const {
+        return elements == 0 || order(leaves()[elements - 1], x);
+    }
+
+    template <typename Cmp>
+    size_t descend(const T& x, Cmp order, bool simd) const {
+        if (beyondLast(x, order))
+            return elements;
+        size_t k = 0;
+        for (size_t layer = layerNodes.size() - 1; layer > 0; --layer)
+            k = k * (nodeKeys + 1) + nodeRank(node(layer, k), x, order, simd);
+        return std::min(k * nodeKeys + nodeRank(node(0, k), x, order, simd), elements);
+    }
+
+    // Các truy vấn của một nhóm đi xuống cùng nhau từng tầng, nút tiếp theo của mỗi truy vấn được prefetch ngay
+    template <typename Cmp, typename Sink>
+    void batch(const T* queries, size_t m, Cmp order, Sink sink) const {
+        constexpr size_t group = search_index_detail::batchGroup;
+        const bool simd = simdNodeWidth<T>(order) == nodeKeys;
+        for (size_t start = 0; start < m; start += group) {
+            const size_t g = std::min(group, m - start);
+            size_t k[group];
+            bool active[group];
+            for (size_t j = 0; j < g; ++j) {
+                k[j] = 0;
+                active[j] = !beyondLast(queries[start + j], order);
+            }
+            for (size_t layer = layerNodes.size(); layer-- > 1;)
+                for (size_t j = 0; j < g; ++j)
+                    if (active[j]) {
+                        k[j] = k[j] * (nodeKeys + 1) + nodeRank(node(layer, k[j]), queries[start + j], order, simd);
+                        search_index_detail::prefetch(node(layer - 1, k[j]));
+                    }
+            for (size_t j = 0; j < g; ++j)
+                sink(start + j, active[j] ? std::min(k[j] * nodeKeys + nodeRank(node(0, k[j]), queries[start + j], order, simd), elements)
+                                          : elements);
+        }
+    }
+
+    Compare comp;
+    size_t elements;
+    std::vector<size_t> layerNodes;   // số nút của từng tầng, tầng 0 là tầng lá
+    std::vector<size_t> layerStart;   // vị trí (tính theo khóa) của nút đầu tiên mỗi tầng trong keys
+    search_index_detail::AlignedArray<T> keys;
+};
+
+#endif
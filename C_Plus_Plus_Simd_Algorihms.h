@@ -0,0 +1,517 @@
+#ifndef _C_PLUS_PLUS_SIMD_ALGORIHMS_
+#define _C_PLUS_PLUS_SIMD_ALGORIHMS_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <type_traits>
+
+// Mạng sắp xếp (sorting network) và bitonic merge trên thanh ghi AVX2 cho các khối nhỏ float / int32 / double,
+// trộn hai dãy đã sắp xếp float / int32 / int64 / double, và tìm kiếm trong nút 64 byte của cây tìm kiếm tĩnh.
+// Mã AVX2 được biên dịch riêng bằng "#pragma GCC target" và chỉ được gọi khi CPU hỗ trợ (kiểm tra CPUID lúc chạy),
+// các trình biên dịch / kiến trúc khác luôn dùng nhánh vô hướng (scalar) của thuật toán gọi.
+#if defined(__GNUC__) && !defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+#define CPP_DSA_SIMD_AVX2 1
+#include <immintrin.h>
+#endif
+
+// CPU hiện tại có hỗ trợ AVX2 hay không (chỉ kiểm tra một lần)
+inline bool cpuHasAvx2() {
+#ifdef CPP_DSA_SIMD_AVX2
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+#ifdef CPP_DSA_SIMD_AVX2
+namespace simd_detail {
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+struct Avx2Float {
+    using Scalar = float;
+    using Vec = __m256;
+    static constexpr int lanes = 8;
+
+    static Vec load(const float* p) { return _mm256_loadu_ps(p); }
+    static void store(float* p, Vec v) { _mm256_storeu_ps(p, v); }
+    // Không dùng _mm256_min_ps / _mm256_max_ps: khi hai giá trị bằng nhau (-0.0 và +0.0) cả hai trả về toán hạng thứ hai,
+    // phép so sánh-đổi chỗ ghi hai bản của một giá trị. Chọn bằng một mặt nạ chung: min(a, b) và max(a, b) luôn là a, b
+    // hoặc b, a, không bao giờ nhân đôi một phần tử
+    static Vec less(Vec a, Vec b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static Vec min(Vec a, Vec b) { return _mm256_blendv_ps(a, b, less(b, a)); }
+    static Vec max(Vec a, Vec b) { return _mm256_blendv_ps(b, a, less(b, a)); }
+    static Vec reverse(Vec v) { return _mm256_permutevar8x32_ps(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0)); }
+    // Đảo thứ tự (đổi dấu, giữ nguyên các bit khác) và kiểm tra NaN, dùng khi trộn
+    static Vec flip(Vec v) { return _mm256_xor_ps(v, _mm256_set1_ps(-0.0f)); }
+    static bool hasNaN(Vec v) { return _mm256_movemask_ps(_mm256_cmp_ps(v, v, _CMP_UNORD_Q)) != 0; }
+
+    // Sắp xếp tăng dần một vector bitonic: so sánh khoảng cách 4, 2, 1. Làn cao lấy max(p, v) để cặp làn so sánh cùng
+    // một phép less(làn cao, làn thấp) và đổi chỗ nhất quán
+    static Vec clean(Vec v) {
+        Vec p = _mm256_permute2f128_ps(v, v, 1);
+        v = _mm256_blend_ps(min(v, p), max(p, v), 0xF0);
+        p = _mm256_permute_ps(v, _MM_SHUFFLE(1, 0, 3, 2));
+        v = _mm256_blend_ps(min(v, p), max(p, v), 0xCC);
+        p = _mm256_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1));
+        return _mm256_blend_ps(min(v, p), max(p, v), 0xAA);
+    }
+
+    // Chuyển vị ma trận 8x8
+    static void transpose(Vec* r) {
+        Vec t0 = _mm256_unpacklo_ps(r[0], r[1]), t1 = _mm256_unpackhi_ps(r[0], r[1]);
+        Vec t2 = _mm256_unpacklo_ps(r[2], r[3]), t3 = _mm256_unpackhi_ps(r[2], r[3]);
+        Vec t4 = _mm256_unpacklo_ps(r[4], r[5]), t5 = _mm256_unpackhi_ps(r[4], r[5]);
+        Vec t6 = _mm256_unpacklo_ps(r[6], r[7]), t7 = _mm256_unpackhi_ps(r[6], r[7]);
+        Vec s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)), s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+        Vec s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)), s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+        Vec s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0)), s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+        Vec s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0)), s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+        r[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+        r[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+        r[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+        r[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+        r[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+        r[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+        r[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+        r[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+    }
+};
+
+struct Avx2Int32 {
+    using Scalar = int32_t;
+    using Vec = __m256i;
+    static constexpr int lanes = 8;
+
+    static Vec load(const int32_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void store(int32_t* p, Vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    static Vec min(Vec a, Vec b) { return _mm256_min_epi32(a, b); }
+    static Vec max(Vec a, Vec b) { return _mm256_max_epi32(a, b); }
+    static Vec reverse(Vec v) { return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0)); }
+    static Vec flip(Vec v) { return _mm256_xor_si256(v, _mm256_set1_epi32(-1)); } // ~x đảo thứ tự, không tràn số
+    static bool hasNaN(Vec) { return false; }
+
+    static Vec clean(Vec v) {
+        Vec p = _mm256_permute2x128_si256(v, v, 1);
+        v = _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), 0xF0);
+        p = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+        v = _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), 0xCC);
+        p = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+        return _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), 0xAA);
+    }
+
+    // Chuyển vị theo bit giống hệt float
+    static void transpose(Vec* r) {
+        __m256 f[8];
+        for (int i = 0; i < 8; ++i) f[i] = _mm256_castsi256_ps(r[i]);
+        Avx2Float::transpose(f);
+        for (int i = 0; i < 8; ++i) r[i] = _mm256_castps_si256(f[i]);
+    }
+};
+
+struct Avx2Double {
+    using Scalar = double;
+    using Vec = __m256d;
+    static constexpr int lanes = 4;
+
+    static Vec load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, Vec v) { _mm256_storeu_pd(p, v); }
+    // Chọn bằng một mặt nạ chung như Avx2Float, không làm mất -0.0 / +0.0
+    static Vec less(Vec a, Vec b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static Vec min(Vec a, Vec b) { return _mm256_blendv_pd(a, b, less(b, a)); }
+    static Vec max(Vec a, Vec b) { return _mm256_blendv_pd(b, a, less(b, a)); }
+    static Vec reverse(Vec v) { return _mm256_permute4x64_pd(v, _MM_SHUFFLE(0, 1, 2, 3)); }
+    static Vec flip(Vec v) { return _mm256_xor_pd(v, _mm256_set1_pd(-0.0)); }
+    static bool hasNaN(Vec v) { return _mm256_movemask_pd(_mm256_cmp_pd(v, v, _CMP_UNORD_Q)) != 0; }
+
+    static Vec clean(Vec v) {
+        Vec p = _mm256_permute2f128_pd(v, v, 1);
+        v = _mm256_blend_pd(min(v, p), max(p, v), 0xC);
+        p = _mm256_permute_pd(v, 0x5);
+        return _mm256_blend_pd(min(v, p), max(p, v), 0xA);
+    }
+
+    // Chuyển vị ma trận 4x4
+    static void transpose(Vec* r) {
+        Vec t0 = _mm256_unpacklo_pd(r[0], r[1]), t1 = _mm256_unpackhi_pd(r[0], r[1]);
+        Vec t2 = _mm256_unpacklo_pd(r[2], r[3]), t3 = _mm256_unpackhi_pd(r[2], r[3]);
+        r[0] = _mm256_permute2f128_pd(t0, t2, 0x20);
+        r[1] = _mm256_permute2f128_pd(t1, t3, 0x20);
+        r[2] = _mm256_permute2f128_pd(t0, t2, 0x31);
+        r[3] = _mm256_permute2f128_pd(t1, t3, 0x31);
+    }
+};
+
+// AVX2 không có min/max cho số nguyên 64 bit: so sánh rồi chọn bằng blendv
+struct Avx2Int64 {
+    using Scalar = int64_t;
+    using Vec = __m256i;
+    static constexpr int lanes = 4;
+
+    static Vec load(const int64_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void store(int64_t* p, Vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    static Vec min(Vec a, Vec b) { return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b)); }
+    static Vec max(Vec a, Vec b) { return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b)); }
+    static Vec reverse(Vec v) { return _mm256_permute4x64_epi64(v, _MM_SHUFFLE(0, 1, 2, 3)); }
+    static Vec flip(Vec v) { return _mm256_xor_si256(v, _mm256_set1_epi32(-1)); }
+    static bool hasNaN(Vec) { return false; }
+
+    static Vec clean(Vec v) {
+        Vec p = _mm256_permute4x64_epi64(v, _MM_SHUFFLE(1, 0, 3, 2));
+        v = _mm256_blend_epi32(min(v, p), max(p, v), 0xF0);
+        p = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+        return _mm256_blend_epi32(min(v, p), max(p, v), 0xCC);
+    }
+};
+
+// Sắp xếp tăng dần 8 thanh ghi (8 * lanes phần tử): mạng sắp xếp theo cột, chuyển vị để mỗi thanh ghi là một dãy
+// đã sắp xếp, sau đó bitonic merge các cặp dãy 1+1, 2+2, 4+4 thanh ghi.
+template <typename Tr>
+struct NetworkSorter {
+    using Vec = typename Tr::Vec;
+    using Scalar = typename Tr::Scalar;
+    static constexpr int registers = 8;
+    static constexpr int capacity = registers * Tr::lanes;
+
+    // Hoán đổi theo làn: min / max của các trait dùng chung một mặt nạ nên kết quả luôn là hoán vị của a, b
+    static void compareSwap(Vec& a, Vec& b) {
+        Vec low = Tr::min(a, b);
+        b = Tr::max(a, b);
+        a = low;
+    }
+
+    // Mạng sắp xếp tối ưu 19 phép so sánh cho 8 đầu vào
+    static void network8(Vec* v) {
+        compareSwap(v[0], v[2]); compareSwap(v[1], v[3]); compareSwap(v[4], v[6]); compareSwap(v[5], v[7]);
+        compareSwap(v[0], v[4]); compareSwap(v[1], v[5]); compareSwap(v[2], v[6]); compareSwap(v[3], v[7]);
+        compareSwap(v[0], v[1]); compareSwap(v[2], v[3]); compareSwap(v[4], v[5]); compareSwap(v[6], v[7]);
+        compareSwap(v[2], v[4]); compareSwap(v[3], v[5]);
+        compareSwap(v[1], v[4]); compareSwap(v[3], v[6]);
+        compareSwap(v[1], v[2]); compareSwap(v[3], v[4]); compareSwap(v[5], v[6]);
+    }
+
+    // Mạng sắp xếp 5 phép so sánh cho 4 đầu vào
+    static void network4(Vec* v) {
+        compareSwap(v[0], v[1]); compareSwap(v[2], v[3]);
+        compareSwap(v[0], v[2]); compareSwap(v[1], v[3]);
+        compareSwap(v[1], v[2]);
+    }
+
+    // v[0..count) là một dãy bitonic theo thứ tự phần tử: half-cleaner giữa các thanh ghi rồi trong từng thanh ghi
+    static void cleanRun(Vec* v, int count) {
+        for (int distance = count / 2; distance >= 1; distance /= 2)
+            for (int k = 0; k < count; ++k)
+                if ((k & distance) == 0)
+                    compareSwap(v[k], v[k + distance]);
+        for (int k = 0; k < count; ++k)
+            v[k] = Tr::clean(v[k]);
+    }
+
+    // Trộn hai dãy tăng v[0..count) và v[count..2*count)
+    static void bitonicMerge(Vec* v, int count) {
+        for (int k = 0; k < count / 2; ++k)
+            std::swap(v[count + k], v[2 * count - 1 - k]);
+        for (int k = 0; k < count; ++k)
+            v[count + k] = Tr::reverse(v[count + k]);
+        for (int k = 0; k < count; ++k)
+            compareSwap(v[k], v[count + k]);
+        cleanRun(v, count);
+        cleanRun(v + count, count);
+    }
+
+    static void sort(Scalar* block) {
+        Vec v[registers];
+        for (int i = 0; i < registers; ++i)
+            v[i] = Tr::load(block + i * Tr::lanes);
+
+        if constexpr (Tr::lanes == 8) {
+            network8(v);
+            Tr::transpose(v);
+        } else {
+            network4(v);
+            network4(v + 4);
+            Tr::transpose(v);
+            Tr::transpose(v + 4);
+        }
+        for (int count = 1; count < registers; count *= 2)
+            for (int i = 0; i < registers; i += 2 * count)
+                bitonicMerge(v + i, count);
+
+        for (int i = 0; i < registers; ++i)
+            Tr::store(block + i * Tr::lanes, v[i]);
+    }
+};
+
+inline void sortBlock(float* block) { NetworkSorter<Avx2Float>::sort(block); }
+inline void sortBlock(int32_t* block) { NetworkSorter<Avx2Int32>::sort(block); }
+inline void sortBlock(double* block) { NetworkSorter<Avx2Double>::sort(block); }
+
+// Trộn hai dãy tăng dần theo từng khối 2 thanh ghi (Descending: dãy giảm dần, đảo thứ tự bằng flip khi nạp và ghi).
+// Hai thanh ghi lớn nhất của bước trước được trộn bitonic với khối tiếp theo của dãy có phần tử đầu nhỏ hơn: nửa nhỏ
+// không lớn hơn mọi phần tử chưa ghi nên được ghi ngay, nửa lớn giữ lại cho bước sau. Con trỏ được chọn bằng phép toán,
+// không có nhánh phụ thuộc dữ liệu. Dừng khi một dãy còn dưới một khối hoặc khi gặp NaN (NaN không có thứ tự, mạng
+// so sánh không trộn đúng)
+template <typename Tr, bool Descending>
+struct BitonicMerger {
+    using Vec = typename Tr::Vec;
+    using Scalar = typename Tr::Scalar;
+    static constexpr int lanes = Tr::lanes;
+    static constexpr std::ptrdiff_t block = 2 * Tr::lanes;
+
+    static Vec load(const Scalar* p) { return Descending ? Tr::flip(Tr::load(p)) : Tr::load(p); }
+    static void store(Scalar* p, Vec v) { Tr::store(p, Descending ? Tr::flip(v) : v); }
+
+    static size_t merge(const Scalar*& a, const Scalar* aEnd, const Scalar*& b, const Scalar* bEnd, Scalar*& out,
+                        Scalar* pending) {
+        if (aEnd - a < block || bEnd - b < block)
+            return 0;
+        Vec v[4] = {load(a), load(a + lanes), load(b), load(b + lanes)};
+        if (Tr::hasNaN(v[0]) | Tr::hasNaN(v[1]) | Tr::hasNaN(v[2]) | Tr::hasNaN(v[3]))
+            return 0;
+        a += block;
+        b += block;
+        for (;;) {
+            NetworkSorter<Tr>::bitonicMerge(v, 2);
+            store(out, v[0]);
+            store(out + lanes, v[1]);
+            out += block;
+            v[0] = v[2];
+            v[1] = v[3];
+            if (aEnd - a < block || bEnd - b < block)
+                break;
+            const bool takeA = Descending ? !(*a < *b) : !(*b < *a);
+            const Scalar* next = takeA ? a : b;
+            v[2] = load(next);
+            v[3] = load(next + lanes);
+            if (Tr::hasNaN(v[2]) | Tr::hasNaN(v[3]))
+                break;
+            a += takeA ? block : 0;
+            b += takeA ? 0 : block;
+        }
+        store(pending, v[0]);
+        store(pending + lanes, v[1]);
+        return block;
+    }
+};
+
+template <typename Tr>
+size_t mergeBlocks(const typename Tr::Scalar*& a, const typename Tr::Scalar* aEnd, const typename Tr::Scalar*& b,
+                   const typename Tr::Scalar* bEnd, typename Tr::Scalar*& out, typename Tr::Scalar* pending, bool descending) {
+    return descending ? BitonicMerger<Tr, true>::merge(a, aEnd, b, bEnd, out, pending)
+                      : BitonicMerger<Tr, false>::merge(a, aEnd, b, bEnd, out, pending);
+}
+
+inline size_t mergeBlocks(const float*& a, const float* aEnd, const float*& b, const float* bEnd, float*& out,
+                          float* pending, bool descending) {
+    return mergeBlocks<Avx2Float>(a, aEnd, b, bEnd, out, pending, descending);
+}
+
+inline size_t mergeBlocks(const int32_t*& a, const int32_t* aEnd, const int32_t*& b, const int32_t* bEnd, int32_t*& out,
+                          int32_t* pending, bool descending) {
+    return mergeBlocks<Avx2Int32>(a, aEnd, b, bEnd, out, pending, descending);
+}
+
+inline size_t mergeBlocks(const double*& a, const double* aEnd, const double*& b, const double* bEnd, double*& out,
+                          double* pending, bool descending) {
+    return mergeBlocks<Avx2Double>(a, aEnd, b, bEnd, out, pending, descending);
+}
+
+inline size_t mergeBlocks(const int64_t*& a, const int64_t* aEnd, const int64_t*& b, const int64_t* bEnd, int64_t*& out,
+                          int64_t* pending, bool descending) {
+    return mergeBlocks<Avx2Int64>(a, aEnd, b, bEnd, out, pending, descending);
+}
+
+// Số khóa của một nút 64 byte (2 thanh ghi, căn lề 64 byte) đứng trước x: nhỏ hơn x khi tăng dần, lớn hơn x khi giảm dần.
+// So sánh cả nút một lần rồi đếm bit của mặt nạ, không có nhánh phụ thuộc dữ liệu
+inline unsigned nodeRank(const float* node, float x, bool descending) {
+    const __m256 key = _mm256_set1_ps(x);
+    const __m256 low = _mm256_load_ps(node), high = _mm256_load_ps(node + 8);
+    const unsigned mask = descending
+        ? _mm256_movemask_ps(_mm256_cmp_ps(low, key, _CMP_GT_OQ)) | _mm256_movemask_ps(_mm256_cmp_ps(high, key, _CMP_GT_OQ)) << 8
+        : _mm256_movemask_ps(_mm256_cmp_ps(low, key, _CMP_LT_OQ)) | _mm256_movemask_ps(_mm256_cmp_ps(high, key, _CMP_LT_OQ)) << 8;
+    return __builtin_popcount(mask);
+}
+
+inline unsigned nodeRank(const int32_t* node, int32_t x, bool descending) {
+    const __m256i key = _mm256_set1_epi32(x);
+    const __m256i low = _mm256_load_si256(reinterpret_cast<const __m256i*>(node));
+    const __m256i high = _mm256_load_si256(reinterpret_cast<const __m256i*>(node + 8));
+    const __m256i before = descending
+        ? _mm256_packs_epi32(_mm256_cmpgt_epi32(low, key), _mm256_cmpgt_epi32(high, key))
+        : _mm256_packs_epi32(_mm256_cmpgt_epi32(key, low), _mm256_cmpgt_epi32(key, high));
+    return __builtin_popcount(_mm256_movemask_epi8(before)) / 2;
+}
+
+inline unsigned nodeRank(const double* node, double x, bool descending) {
+    const __m256d key = _mm256_set1_pd(x);
+    const __m256d low = _mm256_load_pd(node), high = _mm256_load_pd(node + 4);
+    const unsigned mask = descending
+        ? _mm256_movemask_pd(_mm256_cmp_pd(low, key, _CMP_GT_OQ)) | _mm256_movemask_pd(_mm256_cmp_pd(high, key, _CMP_GT_OQ)) << 4
+        : _mm256_movemask_pd(_mm256_cmp_pd(low, key, _CMP_LT_OQ)) | _mm256_movemask_pd(_mm256_cmp_pd(high, key, _CMP_LT_OQ)) << 4;
+    return __builtin_popcount(mask);
+}
+
+inline unsigned nodeRank(const int64_t* node, int64_t x, bool descending) {
+    const __m256i key = _mm256_set1_epi64x(x);
+    const __m256i low = _mm256_load_si256(reinterpret_cast<const __m256i*>(node));
+    const __m256i high = _mm256_load_si256(reinterpret_cast<const __m256i*>(node + 4));
+    const __m256i before = descending
+        ? _mm256_packs_epi32(_mm256_cmpgt_epi64(low, key), _mm256_cmpgt_epi64(high, key))
+        : _mm256_packs_epi32(_mm256_cmpgt_epi64(key, low), _mm256_cmpgt_epi64(key, high));
+    return __builtin_popcount(_mm256_movemask_epi8(before)) / 4;
+}
+
+#pragma GCC pop_options
+
+} // namespace simd_detail
+#endif
+
+// Kernel sắp xếp khối nhỏ: capacity = số phần tử tối đa một lần gọi, 0 nghĩa là kiểu không được hỗ trợ
+template <typename T>
+struct SimdSortKernel {
+    static constexpr size_t capacity = 0;
+    static bool sort(T*, size_t, bool) { return false; }
+};
+
+// Phần chung cho float / int32 / double: chép vào khối đệm, lấp phần trống bằng giá trị lớn nhất,
+// sắp xếp tăng trên thanh ghi rồi chép ra (đảo ngược khi Descending).
+template <typename T, size_t Capacity>
+struct SimdSortKernelBase {
+    static constexpr size_t capacity = Capacity;
+
+    // Trả về false (không đụng vào dữ liệu) khi CPU không có AVX2, khối quá lớn hoặc có NaN
+    static bool sort(T* first, size_t n, bool descending) {
+#ifdef CPP_DSA_SIMD_AVX2
+        if (n > Capacity || !cpuHasAvx2())
+            return false;
+        alignas(32) T block[Capacity];
+        for (size_t i = 0; i < n; ++i) {
+            if constexpr (std::numeric_limits<T>::has_quiet_NaN)
+                if (first[i] != first[i])
+                    return false; // NaN không có thứ tự, mạng so sánh không sắp xếp đúng
+            block[i] = first[i];
+        }
+        const T padding = std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+                                                                : std::numeric_limits<T>::max();
+        std::fill(block + n, block + Capacity, padding);
+        simd_detail::sortBlock(block);
+        if (descending)
+            std::reverse_copy(block, block + n, first);
+        else
+            std::copy(block, block + n, first);
+        return true;
+#else
+        (void)first, (void)n, (void)descending;
+        return false;
+#endif
+    }
+};
+
+template <> struct SimdSortKernel<float> : SimdSortKernelBase<float, 64> {};
+template <> struct SimdSortKernel<int32_t> : SimdSortKernelBase<int32_t, 64> {};
+template <> struct SimdSortKernel<double> : SimdSortKernelBase<double, 32> {};
+
+// Kích thước khối mà kernel SIMD xử lí được với bộ so sánh comp, 0 nếu phải dùng nhánh vô hướng
+template <typename T, typename Compare>
+size_t simdSortCapacity(Compare) { return 0; }
+
+template <typename T>
+size_t simdSortCapacity(std::less<T>) { return cpuHasAvx2() ? SimdSortKernel<T>::capacity : 0; }
+
+template <typename T>
+size_t simdSortCapacity(std::greater<T>) { return cpuHasAvx2() ? SimdSortKernel<T>::capacity : 0; }
+
+// Kernel trộn hai dãy đã sắp xếp: block = số phần tử mỗi bước, 0 nghĩa là kiểu không được hỗ trợ.
+// merge() ghi phần đầu của phép trộn a, b vào out chừng nào cả hai dãy còn ít nhất block phần tử, tiến a, b, out tương
+// ứng và để lại block phần tử lớn nhất đã nạp (đã sắp xếp) trong pending; trả về số phần tử trong pending, 0 nếu không
+// làm gì (CPU không có AVX2, dãy quá ngắn hoặc có NaN ở khối đầu). Không ổn định: các phần tử bằng nhau có thể đổi chỗ
+template <typename T>
+struct SimdMergeKernel {
+    static constexpr size_t block = 0;
+    static size_t merge(const T*&, const T*, const T*&, const T*, T*&, T*, bool) { return 0; }
+};
+
+template <typename T, size_t Block>
+struct SimdMergeKernelBase {
+    static constexpr size_t block = Block;
+
+    static size_t merge(const T*& a, const T* aEnd, const T*& b, const T* bEnd, T*& out, T* pending, bool descending) {
+#ifdef CPP_DSA_SIMD_AVX2
+        if (!cpuHasAvx2())
+            return 0;
+        return simd_detail::mergeBlocks(a, aEnd, b, bEnd, out, pending, descending);
+#else
+        (void)a, (void)aEnd, (void)b, (void)bEnd, (void)out, (void)pending, (void)descending;
+        return 0;
+#endif
+    }
+};
+
+template <> struct SimdMergeKernel<float> : SimdMergeKernelBase<float, 16> {};
+template <> struct SimdMergeKernel<int32_t> : SimdMergeKernelBase<int32_t, 16> {};
+template <> struct SimdMergeKernel<double> : SimdMergeKernelBase<double, 8> {};
+template <> struct SimdMergeKernel<int64_t> : SimdMergeKernelBase<int64_t, 8> {};
+
+// Số phần tử mỗi bước của kernel trộn SIMD với bộ so sánh comp, 0 nếu phải dùng nhánh vô hướng
+template <typename T, typename Compare>
+size_t simdMergeBlock(Compare) { return 0; }
+
+template <typename T>
+size_t simdMergeBlock(std::less<T>) { return cpuHasAvx2() ? SimdMergeKernel<T>::block : 0; }
+
+template <typename T>
+size_t simdMergeBlock(std::greater<T>) { return cpuHasAvx2() ? SimdMergeKernel<T>::block : 0; }
+
+// Tìm kiếm trong một nút 64 byte của cây tìm kiếm tĩnh (StaticBTreeIndex): width = số khóa của nút, 0 nghĩa là kiểu
+// không được hỗ trợ. rank() chỉ được gọi khi cpuHasAvx2() và nút được căn lề 64 byte
+template <typename T>
+struct SimdNodeSearch {
+    static constexpr size_t width = 0;
+    static size_t rank(const T*, T, bool) { return 0; }
+};
+
+template <typename T, size_t Width>
+struct SimdNodeSearchBase {
+    static constexpr size_t width = Width;
+
+    static size_t rank(const T* node, T x, bool descending) {
+#ifdef CPP_DSA_SIMD_AVX2
+        return simd_detail::nodeRank(node, x, descending);
+#else
+        (void)node, (void)x, (void)descending;
+        return 0;
+#endif
+    }
+};
+
+template <> struct SimdNodeSearch<float> : SimdNodeSearchBase<float, 16> {};
+template <> struct SimdNodeSearch<int32_t> : SimdNodeSearchBase<int32_t, 16> {};
+template <> struct SimdNodeSearch<double> : SimdNodeSearchBase<double, 8> {};
+template <> struct SimdNodeSearch<int64_t> : SimdNodeSearchBase<int64_t, 8> {};
+
+// Số khóa của một nút mà kernel SIMD tìm kiếm được với bộ so sánh comp, 0 nếu phải dùng nhánh vô hướng
+template <typename T, typename Compare>
+size_t simdNodeWidth(Compare) { return 0; }
+
+template <typename T>
+size_t simdNodeWidth(std::less<T>) { return cpuHasAvx2() ? SimdNodeSearch<T>::width : 0; }
+
+template <typename T>
+size_t simdNodeWidth(std::greater<T>) { return cpuHasAvx2() ? SimdNodeSearch<T>::width : 0; }
+
+// Sắp xếp first[0, n) bằng kernel SIMD nếu được, trả về false để người gọi dùng nhánh vô hướng
+template <typename T, typename Compare>
+bool simdSmallSort(T*, size_t, Compare) { return false; }
+
+template <typename T>
+bool simdSmallSort(T* first, size_t n, std::less<T>) { return SimdSortKernel<T>::sort(first, n, false); }
+
+template <typename T>
+bool simdSmallSort(T* first, size_t n, std::greater<T>) { return SimdSortKernel<T>::sort(first, n, true); }
+
+#endif
@@ -0,0 +1,324 @@
+#ifndef _C_PLUS_PLUS_SORT_ARENA_ALGORIHMS_
+#define _C_PLUS_PLUS_SORT_ARENA_ALGORIHMS_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Nguồn cấp phát vùng đệm (scratch) cho các thuật toán sắp xếp. Mọi vùng đệm bên trong thư viện là std::pmr::vector,
+// lấy bộ nhớ từ memory_resource truyền vào constructor (MergeSort, ParallelMergeSort, IncrementalSort, StringSort)
+// hoặc từ std::pmr::get_default_resource() nếu không truyền gì.
+//
+// SortArena giữ lại các khối đã được trả về thay vì giải phóng ngay, và cấp lại chúng cho các lần xin sau: sau lần
+// sắp xếp đầu tiên, các lần sắp xếp cùng cỡ (hoặc nhỏ hơn) không cấp phát thêm gì. Khác với
+// std::pmr::unsynchronized_pool_resource, khối lớn (vùng đệm cỡ cả mảng) cũng được giữ lại chứ không trả thẳng về upstream.
+// Kích thước khối được làm tròn lên lũy thừa 2 để các mảng có kích thước gần nhau dùng chung được khối.
+// Dùng được từ nhiều luồng (có mutex); SortArena phải sống lâu hơn mọi đối tượng đang dùng nó.
+// VD: SortArena arena; MergeSort<std::string> sorter(names, SortDirection::Ascending, &arena);
+class SortArena : public std::pmr::memory_resource {
+public:
+    explicit SortArena(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource()) : upstream(upstream) {}
+
+    SortArena(const SortArena&) = delete;
+    SortArena& operator=(const SortArena&) = delete;
+
+    ~SortArena() override { release(); }
+
+    // Trả mọi khối đang rảnh về upstream (các khối đang được dùng không bị ảnh hưởng)
+    void release() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const Block& block : idle)
+            upstream->deallocate(block.address, block.bytes, block.alignment);
+        idle.clear();
+    }
+
+    // Số lần phải xin bộ nhớ từ upstream kể từ khi tạo: không tăng nữa nghĩa là đã đạt trạng thái ổn định
+    size_t upstreamAllocations() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return allocations;
+    }
+
+    // Tổng số byte đang được giữ lại trong các khối rảnh
+    size_t idleBytes() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        size_t total = 0;
+        for (const Block& block : idle)
+            total += block.bytes;
+        return total;
+    }
+
+private:
+    struct Block {
+        void* address;
+        size_t bytes;
+        size_t alignment;
+    };
+
+    static size_t roundUp(size_t bytes) {
+        size_t rounded = 64;
+        while (rounded < bytes)
+            rounded *= 2;
+        return rounded;
+    }
+
+    // Lấy khối rảnh nhỏ nhất đủ chỗ, không có thì xin upstream
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto best = idle.end();
+        for (auto it = idle.begin(); it != idle.end(); ++it)
+            if (it->bytes >= bytes && it->alignment >= alignment && (best == idle.end() || it->bytes < best->bytes))
+                best = it;
+        Block block;
+        if (best != idle.end()) {
+            block = *best;
+            idle.erase(best);
+        } else {
+            block.bytes = roundUp(bytes);
+            block.alignment = std::max(alignment, alignof(std::max_align_t));
+            block.address = upstream->allocate(block.bytes, block.alignment);
+            ++allocations;
+        }
+        busy.push_back(block);
+        return block.address;
+    }
+
+    void do_deallocate(void* address, size_t, size_t) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = std::find_if(busy.begin(), busy.end(), [address](const Block& block) { return block.address == address; });
+        if (it == busy.end())
+            return;
+        idle.push_back(*it);
+        *it = busy.back();
+        busy.pop_back();
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* upstream;
+    mutable std::mutex mutex;
+    std::vector<Block> idle;
+    std::vector<Block> busy;
+    size_t allocations = 0;
+};
+
+// ----------------------------------------------------------------- Huge pages / NUMA -----------------------------------------------------------------
+// Với hàng tỉ phần tử, mảng dữ liệu và vùng đệm lên tới hàng chục GB: với trang 4 KB mỗi lần truy cập ngẫu nhiên gần như
+// chắc chắn trượt TLB, và trên máy nhiều socket mọi trang nằm ở node của luồng đã ghi nó đầu tiên. Các vùng nhớ dưới đây
+// được căn theo biên 2 MB và đánh dấu MADV_HUGEPAGE để kernel dùng transparent huge page (THP), các trang được đặt lên
+// các node NUMA theo NumaPlacement. Ngoài Linux chỉ còn căn lề 2 MB (không có madvise / mbind).
+
+// Cách đặt các trang của vùng nhớ lớn lên các node NUMA
+enum class NumaPlacement {
+    FirstTouch,  // mặc định của hệ điều hành: trang nằm ở node của luồng ghi vào nó đầu tiên
+    Interleave   // rải lần lượt từng trang lên mọi node có bộ nhớ (mbind MPOL_INTERLEAVE), băng thông chia đều
+};
+
+namespace sort_arena_detail {
+
+constexpr size_t hugePageBytes = size_t(2) << 20;
+
+inline size_t roundToHugePage(size_t bytes) {
+    return (bytes + hugePageBytes - 1) / hugePageBytes * hugePageBytes;
+}
+
+#if defined(__linux__)
+// Mặt nạ các node có bộ nhớ, đọc từ danh sách dạng "0-1,3" của sysfs (rỗng nếu không đọc được)
+inline std::vector<unsigned long> readMemoryNodes() {
+    constexpr size_t bits = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> mask;
+    std::ifstream file("/sys/devices/system/node/has_memory");
+    std::string list;
+    if (!std::getline(file, list))
+        return mask;
+    try {
+        for (size_t pos = 0; pos < list.size();) {
+            size_t comma = std::min(list.find(',', pos), list.size());
+            const std::string part = list.substr(pos, comma - pos);
+            const size_t dash = part.find('-');
+            const unsigned long first = std::stoul(part);
+            const unsigned long last = dash == std::string::npos ? first : std::stoul(part.substr(dash + 1));
+            for (unsigned long node = first; node <= last; ++node) {
+                if (mask.size() <= node / bits)
+                    mask.resize(node / bits + 1);
+                mask[node / bits] |= 1UL << (node % bits);
+            }
+            pos = comma + 1;
+        }
+    } catch (const std::exception&) {
+        mask.clear();
+    }
+    return mask;
+}
+
+inline const std::vector<unsigned long>& memoryNodes() {
+    static const std::vector<unsigned long> nodes = readMemoryNodes();
+    return nodes;
+}
+
+inline size_t memoryNodeCount() {
+    size_t count = 0;
+    for (unsigned long word : memoryNodes())
+        count += static_cast<size_t>(__builtin_popcountl(word));
+    return count;
+}
+#endif
+
+// Cấp ít nhất bytes byte bắt đầu ở biên 2 MB. Các trang chưa được cấp thật cho tới khi bị ghi lần đầu
+inline void* mapHugePages(size_t bytes, NumaPlacement placement) {
+    const size_t length = roundToHugePage(bytes);
+#if defined(__linux__)
+    // Xin dư một huge page rồi trả lại hai đầu thừa, để vùng nhớ bắt đầu đúng biên 2 MB nơi THP mới dùng được
+    void* raw = ::mmap(nullptr, length + hugePageBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED)
+        throw std::bad_alloc();
+    const uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+    const uintptr_t aligned = (start + hugePageBytes - 1) & ~uintptr_t(hugePageBytes - 1);
+    if (aligned > start)
+        ::munmap(raw, aligned - start);
+    if (start + hugePageBytes > aligned)
+        ::munmap(reinterpret_cast<void*>(aligned + length), start + hugePageBytes - aligned);
+    void* address = reinterpret_cast<void*>(aligned);
+
+    // madvise và mbind chỉ là gợi ý về hiệu năng: kernel không hỗ trợ thì vùng nhớ vẫn dùng được bình thường
+#if defined(MADV_HUGEPAGE)
+    ::madvise(address, length, MADV_HUGEPAGE);
+#endif
+    if (placement == NumaPlacement::Interleave && memoryNodeCount() > 1) {
+        constexpr int interleave = 3; // MPOL_INTERLEAVE trong <linux/mempolicy.h>
+        const std::vector<unsigned long>& nodes = memoryNodes();
+        ::syscall(SYS_mbind, address, length, interleave, nodes.data(), nodes.size() * 8 * sizeof(unsigned long) + 1, 0);
+    }
+    return address;
+#else
+    (void)placement;
+    return ::operator new(length, std::align_val_t(hugePageBytes));
+#endif
+}
+
+inline void unmapHugePages(void* address, size_t bytes) {
+#if defined(__linux__)
+    ::munmap(address, roundToHugePage(bytes));
+#else
+    ::operator delete(address, std::align_val_t(hugePageBytes));
+    (void)bytes;
+#endif
+}
+
+} // namespace sort_arena_detail
+
+// memory_resource cấp các khối từ minBytes trở lên trên huge page (mỗi khối một vùng mmap riêng, căn biên 2 MB),
+// các khối nhỏ hơn lấy từ upstream. Dùng cho vùng đệm của các thuật toán sắp xếp, VD:
+// ParallelMergeSort<float> sorter(keys.data(), n, SortDirection::Ascending, 0, hugePageResource(NumaPlacement::Interleave));
+// Vùng đệm của MergeSort được khởi tạo bởi luồng gọi sort(), nên với sắp xếp song song nên chọn Interleave.
+// Đặt trong một SortArena (SortArena arena(hugePageResource())) để các lần sắp xếp sau dùng lại vùng nhớ đã map.
+class HugePageResource : public std::pmr::memory_resource {
+public:
+    explicit HugePageResource(NumaPlacement placement = NumaPlacement::FirstTouch,
+                              size_t minBytes = sort_arena_detail::hugePageBytes,
+                              std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : placement(placement), minBytes(minBytes), upstream(upstream) {}
+
+    NumaPlacement numaPlacement() const { return placement; }
+
+private:
+    bool huge(size_t bytes, size_t alignment) const {
+        return bytes >= minBytes && alignment <= sort_arena_detail::hugePageBytes;
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        if (!huge(bytes, alignment))
+            return upstream->allocate(bytes, alignment);
+        return sort_arena_detail::mapHugePages(bytes, placement);
+    }
+
+    void do_deallocate(void* address, size_t bytes, size_t alignment) override {
+        if (!huge(bytes, alignment))
+            upstream->deallocate(address, bytes, alignment);
+        else
+            sort_arena_detail::unmapHugePages(address, bytes);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    NumaPlacement placement;
+    size_t minBytes;
+    std::pmr::memory_resource* upstream;
+};
+
+// Các HugePageResource dùng chung cho cả chương trình, tương tự std::pmr::new_delete_resource()
+inline HugePageResource* hugePageResource(NumaPlacement placement = NumaPlacement::FirstTouch) {
+    static HugePageResource firstTouch(NumaPlacement::FirstTouch);
+    static HugePageResource interleave(NumaPlacement::Interleave);
+    return placement == NumaPlacement::Interleave ? &interleave : &firstTouch;
+}
+
+// Mảng size phần tử kiểu số trên huge page, không được khởi tạo: trang chỉ được cấp khi bị ghi lần đầu, nên ghi song song
+// (VD RandomGenerator::fill) với FirstTouch sẽ đặt mỗi trang ở node của luồng ghi nó, gần luồng sẽ sắp xếp đoạn đó.
+template <typename T>
+class HugePageBuffer {
+    static_assert(std::is_trivially_default_constructible<T>::value && std::is_trivially_destructible<T>::value,
+                  "HugePageBuffer holds uninitialized trivial elements");
+
+public:
+    explicit HugePageBuffer(size_t size = 0, NumaPlacement placement = NumaPlacement::FirstTouch) : count(size) {
+        if (size > std::numeric_limits<size_t>::max() / sizeof(T))
+            throw std::length_error("HugePageBuffer: size too large");
+        if (size > 0)
+            address = static_cast<T*>(sort_arena_detail::mapHugePages(size * sizeof(T), placement));
+    }
+
+    HugePageBuffer(HugePageBuffer&& other) noexcept
+        : address(std::exchange(other.address, nullptr)), count(std::exchange(other.count, 0)) {}
+
+    HugePageBuffer& operator=(HugePageBuffer&& other) noexcept {
+        if (this != &other) {
+            release();
+            address = std::exchange(other.address, nullptr);
+            count = std::exchange(other.count, 0);
+        }
+        return *this;
+    }
+
+    HugePageBuffer(const HugePageBuffer&) = delete;
+    HugePageBuffer& operator=(const HugePageBuffer&) = delete;
+
+    ~HugePageBuffer() { release(); }
+
+    T* data() const { return address; }
+    size_t size() const { return count; }
+    T* begin() const { return address; }
+    T* end() const { return address + count; }
+    T& operator[](size_t i) const { return address[i]; }
+
+private:
+    void release() {
+        if (address != nullptr)
+            sort_arena_detail::unmapHugePages(address, count * sizeof(T));
+        address = nullptr;
+    }
+
+    T* address = nullptr;
+    size_t count;
+};
+
+#endif
@@ -0,0 +1,845 @@
+#ifndef _C_PLUS_PLUS_SORT_ENGINE_ALGORIHMS_
+#define _C_PLUS_PLUS_SORT_ENGINE_ALGORIHMS_
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "C_Plus_Plus_Simd_Algorihms.h"
+
+// Phần lõi của các thuật toán sắp xếp, viết trên cặp random-access iterator [first, last) và bộ so sánh comp.
+// Các lớp trong C_Plus_Plus_Data_Structure_Algorihms.h gọi vào đây với con trỏ data, còn các hàm tự do
+// (quickSort(first, last), mergeSort(range)...) gọi trực tiếp nên không đi qua bảng hàm ảo.
+// Kernel SIMD chỉ được dùng khi iterator là con trỏ thô (bộ nhớ liền kề).
+// Các lời gọi nội bộ đều ghi rõ sort_engine:: để ADL không kéo các hàm tự do cùng tên ở namespace toàn cục vào.
+namespace sort_engine {
+
+// Đoạn có số phần tử <= insertionThreshold được sắp bằng insertion sort
+constexpr std::ptrdiff_t insertionThreshold = 16;
+// Đoạn lớn hơn nintherThreshold chọn pivot bằng ninther (trung vị của 3 trung vị), còn lại dùng median-of-3
+constexpr std::ptrdiff_t nintherThreshold = 128;
+// Độ dài tối thiểu của một run trước khi MergeSort bắt đầu trộn
+constexpr std::ptrdiff_t minRun = 32;
+
+template <typename It>
+using ValueOf = typename std::iterator_traits<It>::value_type;
+
+template <typename It>
+using DifferenceOf = typename std::iterator_traits<It>::difference_type;
+
+// ----------------------------------------------------------------- Điểm đo -----------------------------------------------------------------
+// Bộ so sánh kế thừa InstrumentedOrder (CountingOrder trong C_Plus_Plus_Instrumentation_Algorihms.h) được báo thêm các sự kiện
+// ngoài phép so sánh. Với mọi bộ so sánh khác nhánh if constexpr bị loại bỏ lúc biên dịch, vòng lặp giống hệt bản không đo.
+struct InstrumentedOrder {};
+
+template <typename Cmp>
+constexpr bool isInstrumented = std::is_base_of<InstrumentedOrder, Cmp>::value;
+
+enum class SortEvent {
+    Swap,     // đổi chỗ hai phần tử
+    Move,     // ghi một phần tử vào vị trí mới (kể cả vào / ra vùng đệm)
+    Scratch,  // cấp phát vùng đệm, amount tính theo byte
+    Enter,    // vào một cấp đệ quy
+    Leave     // ra khỏi một cấp đệ quy
+};
+
+template <typename Cmp>
+inline void note(const Cmp& comp, SortEvent event, size_t amount = 1) {
+    if constexpr (isInstrumented<Cmp>)
+        comp.note(event, amount);
+    else
+        (void)comp, (void)event, (void)amount;
+}
+
+// std::iter_swap có ghi nhận sự kiện Swap
+template <typename It, typename Cmp>
+inline void exchange(It a, It b, const Cmp& comp) {
+    std::iter_swap(a, b);
+    sort_engine::note(comp, SortEvent::Swap);
+}
+
+// ----------------------------------------------------------------- Sắp xếp cơ bản -----------------------------------------------------------------
+
+template <typename It, typename Cmp>
+void selectionSort(It first, It last, Cmp comp) {
+    for (It i = first; i != last; ++i) {
+        It best = i;
+        for (It j = std::next(i); j != last; ++j)
+            if (comp(*j, *best))
+                best = j;
+        sort_engine::exchange(i, best, comp);
+    }
+}
+
+template <typename It, typename Cmp>
+void bubbleSort(It first, It last, Cmp comp) {
+    for (DifferenceOf<It> n = last - first; n > 1; --n) {
+        bool swapped = false;
+        for (It j = first; j + 1 != first + n; ++j) {
+            if (comp(*(j + 1), *j)) {
+                sort_engine::exchange(j, j + 1, comp);
+                swapped = true;
+            }
+        }
+        if (!swapped) break;
+    }
+}
+
+// Insertion sort ổn định cho [first, last), biết trước [first, sorted) đã sắp xếp
+template <typename It, typename Cmp>
+void insertionSort(It first, It sorted, It last, Cmp comp) {
+    if (sorted == first && sorted != last)
+        ++sorted;
+    for (It i = sorted; i != last; ++i) {
+        ValueOf<It> key = std::move(*i);
+        It j = i;
+        while (j != first && comp(key, *(j - 1))) {
+            *j = std::move(*(j - 1));
+            --j;
+        }
+        *j = std::move(key);
+        sort_engine::note(comp, SortEvent::Move, static_cast<size_t>(i - j) + 2);
+    }
+}
+
+template <typename It, typename Cmp>
+void insertionSort(It first, It last, Cmp comp) {
+    sort_engine::insertionSort(first, first, last, comp);
+}
+
+// ----------------------------------------------------------------- Quick Sort (introsort) -----------------------------------------------------------------
+
+inline int depthLimit(std::ptrdiff_t n) {
+    int depth = 0;
+    while (n > 1) {
+        n >>= 1;
+        ++depth;
+    }
+    return 2 * depth;
+}
+
+// Đoạn lá: khối <= capacity của kernel SIMD (nếu CPU, kiểu dữ liệu và iterator hỗ trợ), ngược lại insertionThreshold
+template <typename It, typename Cmp>
+std::ptrdiff_t leafSize(Cmp comp) {
+    if constexpr (std::is_pointer<It>::value) {
+        size_t simd = simdSortCapacity<ValueOf<It>>(comp);
+        if (simd != 0)
+            return static_cast<std::ptrdiff_t>(simd);
+    }
+    return insertionThreshold;
+}
+
+template <typename It, typename Cmp>
+void smallSort(It first, It last, Cmp comp) {
+    if (last - first < 2)
+        return;
+    if constexpr (std::is_pointer<It>::value) {
+        if (simdSmallSort(first, static_cast<size_t>(last - first), comp))
+            return;
+    }
+    sort_engine::insertionSort(first, last, comp);
+}
+
+// Sắp xếp *a, *b, *c theo thứ tự comp
+template <typename It, typename Cmp>
+void sort3(It a, It b, It c, Cmp comp) {
+    if (comp(*b, *a)) sort_engine::exchange(a, b, comp);
+    if (comp(*c, *b)) {
+        sort_engine::exchange(b, c, comp);
+        if (comp(*b, *a)) sort_engine::exchange(a, b, comp);
+    }
+}
+
+// Đưa pivot được chọn về *first
+template <typename It, typename Cmp>
+void selectPivot(It first, It last, Cmp comp) {
+    DifferenceOf<It> n = last - first;
+    It mid = first + n / 2;
+    It back = last - 1;
+    if (n > nintherThreshold) {
+        DifferenceOf<It> s = n / 8;
+        sort_engine::sort3(first, first + s, first + 2 * s, comp);
+        sort_engine::sort3(mid - s, mid, mid + s, comp);
+        sort_engine::sort3(back - 2 * s, back - s, back, comp);
+        sort_engine::sort3(first + s, mid, back - s, comp);
+    } else if (n >= 3) {
+        sort_engine::sort3(first, mid, back, comp);
+    }
+    sort_engine::exchange(first, mid, comp);
+}
+
+// Phân hoạch 3 nhánh Bentley-McIlroy với pivot tại *first: quét kiểu Hoare, các phần tử bằng pivot
+// được gom về hai đầu rồi đổi vào giữa. Không phát sinh thêm phép đổi chỗ khi các khóa đều khác nhau.
+// Trả về [equalFirst, equalLast) là đoạn các phần tử bằng pivot, đã nằm đúng vị trí cuối cùng. Yêu cầu last - first >= 2.
+template <typename It, typename Cmp>
+std::pair<It, It> fatPartition(It first, It last, Cmp comp) {
+    using Index = DifferenceOf<It>;
+    It d = first;
+    const Index high = (last - first) - 1;
+    const auto& pivot = d[0]; // d[0] không bị di chuyển cho đến vòng đổi chỗ cuối
+    auto equal = [&](const ValueOf<It>& value) { return !comp(value, pivot) && !comp(pivot, value); };
+
+    Index i = 0, j = high + 1;
+    Index p = 0, q = high + 1;
+    for (;;) {
+        while (comp(d[++i], pivot))
+            if (i == high) break;
+        while (comp(pivot, d[--j]))
+            if (j == 0) break;
+        if (i == j && equal(d[i]))
+            sort_engine::exchange(d + (++p), d + i, comp);
+        if (i >= j) break;
+        sort_engine::exchange(d + i, d + j, comp);
+        if (equal(d[i])) sort_engine::exchange(d + (++p), d + i, comp);
+        if (equal(d[j])) sort_engine::exchange(d + (--q), d + j, comp);
+    }
+    i = j + 1;
+    for (Index k = 0; k <= p; ++k) sort_engine::exchange(d + k, d + (j--), comp);
+    for (Index k = high; k >= q; --k) sort_engine::exchange(d + k, d + (i++), comp);
+    return {d + (j + 1), d + i};
+}
+
+template <typename It, typename Cmp>
+void heapSort(It first, It last, Cmp comp) {
+    std::make_heap(first, last, comp);
+    std::sort_heap(first, last, comp);
+}
+
+// ----------------------------------------------------------------- Phân hoạch theo khối -----------------------------------------------------------------
+// Kiểu BlockQuicksort / pdqsort: kết quả so sánh của từng khối được ghi vào mảng offset không qua rẽ nhánh
+// (num += comp(...)), sau đó các cặp phần tử nằm sai phía được đổi chỗ hàng loạt. Trên khóa ngẫu nhiên,
+// phân hoạch kiểu Hoare đoán sai nhánh gần như mỗi phần tử thứ hai; cách này chỉ còn rẽ nhánh theo khối.
+
+// Độ dài khối, vừa với offset kiểu unsigned char
+constexpr std::ptrdiff_t partitionBlock = 64;
+
+// Chỉ dùng phân hoạch theo khối khi phép so sánh rẻ và đoán sai nhánh là chi phí chính: khóa số với
+// AscendingOrder / DescendingOrder. Bộ so sánh có đo đếm được xét theo bộ so sánh bên trong.
+template <typename Cmp, typename = void>
+struct BlockPartitionOrder : std::false_type {};
+
+template <typename T>
+struct BlockPartitionOrder<std::less<T>> : std::is_arithmetic<T> {};
+
+template <typename T>
+struct BlockPartitionOrder<std::greater<T>> : std::is_arithmetic<T> {};
+
+template <typename Cmp>
+struct BlockPartitionOrder<Cmp, std::enable_if_t<isInstrumented<Cmp>>> : BlockPartitionOrder<decltype(std::declval<Cmp>().inner)> {};
+
+// Đổi chỗ num cặp (first + offsetsLeft[i], last - offsetsRight[i]). Khi hai bên có cùng số phần tử sai phía thì đổi chỗ
+// từng cặp (giữ O(n) cho dãy giảm dần), ngược lại đi theo một chu trình: mỗi phần tử chỉ bị ghi một lần.
+template <typename It, typename Cmp>
+void swapOffsets(It first, It last, const unsigned char* offsetsLeft, const unsigned char* offsetsRight, size_t num,
+                 bool useSwaps, Cmp comp) {
+    if (useSwaps) {
+        for (size_t i = 0; i < num; ++i)
+            std::iter_swap(first + offsetsLeft[i], last - offsetsRight[i]);
+        sort_engine::note(comp, SortEvent::Swap, num);
+    } else if (num > 0) {
+        It l = first + offsetsLeft[0];
+        It r = last - offsetsRight[0];
+        ValueOf<It> tmp(std::move(*l));
+        *l = std::move(*r);
+        for (size_t i = 1; i < num; ++i) {
+            l = first + offsetsLeft[i];
+            *r = std::move(*l);
+            r = last - offsetsRight[i];
+            *l = std::move(*r);
+        }
+        *r = std::move(tmp);
+        sort_engine::note(comp, SortEvent::Move, 2 * num + 1);
+    }
+}
+
+// Phân hoạch [begin, end) với pivot tại *begin: các phần tử đứng trước pivot sang trái, còn lại sang phải.
+// Trả về vị trí cuối cùng của pivot và cờ cho biết đoạn đã được phân hoạch sẵn (không phải đổi chỗ phần tử nào).
+// Yêu cầu có một phần tử không đứng trước pivot trong (begin, end), selectPivot() luôn bảo đảm điều này.
+template <typename It, typename Cmp>
+std::pair<It, bool> blockPartition(It begin, It end, Cmp comp) {
+    const ValueOf<It> pivot = *begin;
+    It first = begin;
+    It last = end;
+
+    // Bỏ qua tiền tố đã đứng trước pivot và hậu tố đã không đứng trước pivot
+    while (comp(*++first, pivot)) {}
+    if (first - 1 == begin)
+        while (first < last && !comp(*--last, pivot)) {}
+    else
+        while (!comp(*--last, pivot)) {}
+
+    const bool alreadyPartitioned = first >= last;
+    if (!alreadyPartitioned) {
+        sort_engine::exchange(first, last, comp);
+        ++first;
+
+        alignas(64) unsigned char offsetsLeft[partitionBlock];
+        alignas(64) unsigned char offsetsRight[partitionBlock];
+        size_t numLeft = 0, numRight = 0, startLeft = 0, startRight = 0;
+
+        // [first, last) là phần chưa phân hoạch; mỗi vòng lấy một khối ở mỗi đầu (khối còn dư từ vòng trước được giữ lại)
+        while (last - first > 2 * partitionBlock) {
+            if (numLeft == 0) {
+                startLeft = 0;
+                It it = first;
+                for (unsigned char i = 0; i < partitionBlock; ++i, ++it) {
+                    offsetsLeft[numLeft] = i;
+                    numLeft += !comp(*it, pivot);
+                }
+            }
+            if (numRight == 0) {
+                startRight = 0;
+                It it = last;
+                for (unsigned char i = 1; i <= partitionBlock; ++i) {
+                    offsetsRight[numRight] = i;
+                    numRight += comp(*--it, pivot);
+                }
+            }
+
+            const size_t num = std::min(numLeft, numRight);
+            sort_engine::swapOffsets(first, last, offsetsLeft + startLeft, offsetsRight + startRight, num,
+                                     numLeft == numRight, comp);
+            numLeft -= num;
+            numRight -= num;
+            startLeft += num;
+            startRight += num;
+            if (numLeft == 0)
+                first += partitionBlock;
+            if (numRight == 0)
+                last -= partitionBlock;
+        }
+
+        // Phần còn lại nhỏ hơn ba khối: chia phần chưa xét cho hai phía rồi làm thêm một vòng như trên
+        DifferenceOf<It> leftSize = 0, rightSize = 0;
+        const DifferenceOf<It> unknown = (last - first) - ((numLeft != 0 || numRight != 0) ? partitionBlock : 0);
+        if (numRight != 0) {
+            leftSize = unknown;
+            rightSize = partitionBlock;
+        } else if (numLeft != 0) {
+            leftSize = partitionBlock;
+            rightSize = unknown;
+        } else {
+            leftSize = unknown / 2;
+            rightSize = unknown - leftSize;
+        }
+        if (unknown != 0 && numLeft == 0) {
+            startLeft = 0;
+            It it = first;
+            for (unsigned char i = 0; i < leftSize; ++i, ++it) {
+                offsetsLeft[numLeft] = i;
+                numLeft += !comp(*it, pivot);
+            }
+        }
+        if (unknown != 0 && numRight == 0) {
+            startRight = 0;
+            It it = last;
+            for (unsigned char i = 1; i <= rightSize; ++i) {
+                offsetsRight[numRight] = i;
+                numRight += comp(*--it, pivot);
+            }
+        }
+        const size_t num = std::min(numLeft, numRight);
+        sort_engine::swapOffsets(first, last, offsetsLeft + startLeft, offsetsRight + startRight, num,
+                                 numLeft == numRight, comp);
+        numLeft -= num;
+        numRight -= num;
+        startLeft += num;
+        startRight += num;
+        if (numLeft == 0)
+            first += leftSize;
+        if (numRight == 0)
+            last -= rightSize;
+
+        // Một phía còn phần tử sai chỗ: đưa chúng về sát biên của phía kia
+        if (numLeft != 0) {
+            while (numLeft-- != 0)
+                sort_engine::exchange(first + offsetsLeft[startLeft + numLeft], --last, comp);
+            first = last;
+        }
+        if (numRight != 0) {
+            while (numRight-- != 0)
+                sort_engine::exchange(last - offsetsRight[startRight + numRight], first++, comp);
+            last = first;
+        }
+    }
+
+    It pivotPos = first - 1;
+    sort_engine::exchange(begin, pivotPos, comp);
+    return {pivotPos, alreadyPartitioned};
+}
+
+// Phân hoạch [begin, end) với pivot tại *begin khi phần tử đứng ngay trước đoạn bằng pivot: các phần tử bằng pivot
+// (cũng là nhỏ nhất trong đoạn) được gom sang trái và đã đúng vị trí. Trả về vị trí cuối cùng của pivot.
+template <typename It, typename Cmp>
+It partitionLeft(It begin, It end, Cmp comp) {
+    const ValueOf<It> pivot = *begin;
+    It first = begin;
+    It last = end;
+
+    while (comp(pivot, *--last)) {}
+    if (last + 1 == end)
+        while (first < last && !comp(pivot, *++first)) {}
+    else
+        while (!comp(pivot, *++first)) {}
+
+    while (first < last) {
+        sort_engine::exchange(first, last, comp);
+        while (comp(pivot, *--last)) {}
+        while (!comp(pivot, *++first)) {}
+    }
+    sort_engine::exchange(begin, last, comp);
+    return last;
+}
+
+// Insertion sort dừng lại (trả về false) khi đã phải dời quá 8 phần tử: dùng để thử xem đoạn có gần như đã sắp xếp không
+template <typename It, typename Cmp>
+bool partialInsertionSort(It first, It last, Cmp comp) {
+    if (first == last)
+        return true;
+    size_t moved = 0;
+    for (It i = first + 1; i != last; ++i) {
+        if (!comp(*i, *(i - 1)))
+            continue;
+        ValueOf<It> key = std::move(*i);
+        It j = i;
+        do {
+            *j = std::move(*(j - 1));
+            --j;
+        } while (j != first && comp(key, *(j - 1)));
+        *j = std::move(key);
+        moved += static_cast<size_t>(i - j);
+        sort_engine::note(comp, SortEvent::Move, static_cast<size_t>(i - j) + 2);
+        if (moved > 8)
+            return false;
+    }
+    return true;
+}
+
+// Sau một lần phân hoạch lệch, đổi chỗ vài phần tử ở hai đầu đoạn để lần chọn pivot tiếp theo không rơi lại vào cùng mẫu
+template <typename It, typename Cmp>
+void breakPatterns(It first, It last, Cmp comp) {
+    const DifferenceOf<It> n = last - first;
+    if (n < insertionThreshold)
+        return;
+    const DifferenceOf<It> quarter = n / 4;
+    sort_engine::exchange(first, first + quarter, comp);
+    sort_engine::exchange(last - 1, last - quarter, comp);
+    if (n > nintherThreshold) {
+        sort_engine::exchange(first + 1, first + (quarter + 1), comp);
+        sort_engine::exchange(first + 2, first + (quarter + 2), comp);
+        sort_engine::exchange(last - 2, last - (quarter + 1), comp);
+        sort_engine::exchange(last - 3, last - (quarter + 2), comp);
+    }
+}
+
+// Introsort với phân hoạch theo khối (pdqsort). leftmost = false nghĩa là *(first - 1) là pivot của cấp trên,
+// không đứng sau phần tử nào trong đoạn. badAllowed là số lần phân hoạch lệch (một phía < 1/8) còn được phép
+// trước khi chuyển sang heapsort.
+template <typename It, typename Cmp>
+void blockIntroSort(It first, It last, int badAllowed, bool leftmost, Cmp comp) {
+    const std::ptrdiff_t leaf = sort_engine::leafSize<It>(comp);
+    sort_engine::note(comp, SortEvent::Enter);
+    while (last - first > leaf) {
+        const DifferenceOf<It> n = last - first;
+        sort_engine::selectPivot(first, last, comp);
+
+        // Pivot bằng pivot của cấp trên: đoạn có nhiều khóa trùng, các phần tử bằng pivot không cần sắp xếp tiếp
+        if (!leftmost && !comp(*(first - 1), *first)) {
+            first = sort_engine::partitionLeft(first, last, comp) + 1;
+            continue;
+        }
+
+        std::pair<It, bool> split = sort_engine::blockPartition(first, last, comp);
+        It pivot = split.first;
+        const DifferenceOf<It> leftSize = pivot - first;
+        const DifferenceOf<It> rightSize = last - (pivot + 1);
+        if (leftSize < n / 8 || rightSize < n / 8) {
+            if (--badAllowed == 0) {
+                sort_engine::heapSort(first, last, comp);
+                sort_engine::note(comp, SortEvent::Leave);
+                return;
+            }
+            sort_engine::breakPatterns(first, pivot, comp);
+            sort_engine::breakPatterns(pivot + 1, last, comp);
+        } else if (split.second && sort_engine::partialInsertionSort(first, pivot, comp) &&
+                   sort_engine::partialInsertionSort(pivot + 1, last, comp)) {
+            // Đoạn đã được phân hoạch sẵn và hai phía đều gần như đã sắp xếp
+            sort_engine::note(comp, SortEvent::Leave);
+            return;
+        }
+
+        // Đệ quy vào phía nhỏ hơn, lặp trên phía lớn hơn để stack không vượt O(log n)
+        if (leftSize < rightSize) {
+            sort_engine::blockIntroSort(first, pivot, badAllowed, leftmost, comp);
+            first = pivot + 1;
+            leftmost = false;
+        } else {
+            sort_engine::blockIntroSort(pivot + 1, last, badAllowed, false, comp);
+            last = pivot;
+        }
+    }
+    sort_engine::smallSort(first, last, comp);
+    sort_engine::note(comp, SortEvent::Leave);
+}
+
+// Introsort với phân hoạch 3 nhánh fatPartition: xử lí tốt khóa trùng với mọi bộ so sánh, không cần sao chép pivot
+template <typename It, typename Cmp>
+void fatIntroSort(It first, It last, int depth, Cmp comp) {
+    const std::ptrdiff_t leaf = sort_engine::leafSize<It>(comp);
+    sort_engine::note(comp, SortEvent::Enter);
+    while (last - first > leaf) {
+        if (depth-- == 0) {
+            sort_engine::heapSort(first, last, comp);
+            sort_engine::note(comp, SortEvent::Leave);
+            return;
+        }
+        sort_engine::selectPivot(first, last, comp);
+        std::pair<It, It> equal = sort_engine::fatPartition(first, last, comp);
+        // Đệ quy vào nửa nhỏ hơn, lặp trên nửa lớn hơn để stack không vượt O(log n)
+        if (equal.first - first < last - equal.second) {
+            sort_engine::fatIntroSort(first, equal.first, depth, comp);
+            first = equal.second;
+        } else {
+            sort_engine::fatIntroSort(equal.second, last, depth, comp);
+            last = equal.first;
+        }
+    }
+    sort_engine::smallSort(first, last, comp);
+    sort_engine::note(comp, SortEvent::Leave);
+}
+
+// Khóa số với thứ tự mặc định dùng blockIntroSort (depth là số lần phân hoạch lệch được phép), còn lại dùng fatIntroSort
+template <typename It, typename Cmp>
+void introSort(It first, It last, int depth, Cmp comp) {
+    if constexpr (BlockPartitionOrder<Cmp>::value)
+        sort_engine::blockIntroSort(first, last, depth, true, comp);
+    else
+        sort_engine::fatIntroSort(first, last, depth, comp);
+}
+
+template <typename It, typename Cmp>
+void quickSort(It first, It last, Cmp comp) {
+    if (last - first > 1)
+        sort_engine::introSort(first, last, sort_engine::depthLimit(last - first), comp);
+}
+
+// ----------------------------------------------------------------- Selection -----------------------------------------------------------------
+
+// Chọn bằng heap: giữ (nth - first + 1) phần tử tốt nhất trong một max-heap theo comp, O(n log k)
+template <typename It, typename Cmp>
+void heapSelect(It first, It nth, It last, Cmp comp) {
+    It heapEnd = nth + 1;
+    std::make_heap(first, heapEnd, comp);
+    for (It it = heapEnd; it != last; ++it) {
+        if (comp(*it, *first)) {
+            std::pop_heap(first, heapEnd, comp);
+            sort_engine::exchange(nth, it, comp);
+            std::push_heap(first, heapEnd, comp);
+        }
+    }
+    std::pop_heap(first, heapEnd, comp);
+}
+
+// Introselect: quickselect với cùng pivot và fat partition như introSort, nhưng chỉ đi tiếp vào phía chứa nth
+// (O(n) trung bình). Khi độ sâu vượt 2*log2(n) thì chuyển sang heapSelect để giữ chặn trên O(n log n).
+// Sau khi gọi, *nth là phần tử sẽ đứng ở đó nếu sắp xếp toàn bộ, [first, nth) không đứng sau và (nth, last) không đứng trước nó.
+template <typename It, typename Cmp>
+void nthElement(It first, It nth, It last, Cmp comp) {
+    if (nth == last)
+        return;
+    int depth = sort_engine::depthLimit(last - first);
+    while (last - first > insertionThreshold) {
+        if (depth-- == 0) {
+            sort_engine::heapSelect(first, nth, last, comp);
+            return;
+        }
+        sort_engine::selectPivot(first, last, comp);
+        std::pair<It, It> equal = sort_engine::fatPartition(first, last, comp);
+        if (nth < equal.first)
+            last = equal.first;
+        else if (nth >= equal.second)
+            first = equal.second;
+        else
+            return; // nth nằm trong đoạn bằng pivot, đã đúng vị trí
+    }
+    sort_engine::insertionSort(first, last, comp);
+}
+
+// Sắp xếp k = middle - first phần tử đứng đầu theo comp vào [first, middle), phần còn lại không theo thứ tự.
+// k nhỏ so với n: heapSelect, hầu hết phần tử chỉ tốn một phép so sánh với đỉnh heap rồi bị loại (O(n log k) xấu nhất);
+// k lớn: introselect O(n) rồi sắp xếp k phần tử, O(n + k log k).
+template <typename It, typename Cmp>
+void partialSort(It first, It middle, It last, Cmp comp) {
+    if (first == middle)
+        return;
+    if (middle != last) {
+        if ((middle - first) * 64 <= last - first)
+            sort_engine::heapSelect(first, middle - 1, last, comp);
+        else
+            sort_engine::nthElement(first, middle - 1, last, comp);
+    }
+    sort_engine::quickSort(first, middle, comp);
+}
+
+// ----------------------------------------------------------------- Merge Sort -----------------------------------------------------------------
+
+// Mạng sắp xếp SIMD không ổn định nên chỉ được dùng cho số nguyên, nơi các phần tử bằng nhau không phân biệt được
+// (với float, -0.0 và +0.0 bằng nhau nhưng khác bit)
+template <typename It, typename Cmp>
+size_t stableSimdCapacity(Cmp comp) {
+    if constexpr (std::is_pointer<It>::value && std::is_integral<ValueOf<It>>::value)
+        return simdSortCapacity<ValueOf<It>>(comp);
+    return 0;
+}
+
+// Chia [first, last) thành các run đã sắp xếp: run giảm chặt được đảo ngược, run ngắn được kéo dài tới minRun.
+// runs chứa các biên tương đối [runs[k], runs[k+1]) tính từ first.
+template <typename It, typename Runs, typename Cmp>
+void collectRuns(It first, It last, Runs& runs, Cmp comp) {
+    const size_t n = static_cast<size_t>(last - first);
+    It d = first;
+    runs.clear();
+    runs.push_back(0);
+    size_t start = 0;
+    while (start < n) {
+        size_t end = start + 1;
+        if (end < n) {
+            if (comp(d[end], d[start])) {
+                while (end + 1 < n && comp(d[end + 1], d[end])) ++end;
+                ++end;
+                std::reverse(d + start, d + end);
+                sort_engine::note(comp, SortEvent::Swap, (end - start) / 2);
+            } else {
+                while (end + 1 < n && !comp(d[end + 1], d[end])) ++end;
+                ++end;
+            }
+        }
+        if (end - start < static_cast<size_t>(minRun)) {
+            size_t forced = std::min(n, start + static_cast<size_t>(minRun));
+            if constexpr (std::is_pointer<It>::value) {
+                const size_t block = sort_engine::stableSimdCapacity<It>(comp);
+                if (block != 0) {
+                    forced = std::min(n, start + block);
+                    simdSmallSort(d + start, forced - start, comp);
+                } else {
+                    sort_engine::insertionSort(d + start, d + end, d + forced, comp);
+                }
+            } else {
+                sort_engine::insertionSort(d + start, d + end, d + forced, comp);
+            }
+            end = forced;
+        }
+        runs.push_back(end);
+        start = end;
+    }
+}
+
+// Trộn ổn định [a, aEnd) và [b, bEnd) vào out: khi bằng nhau luôn lấy phần tử của run bên trái trước
+template <typename InA, typename InB, typename Out, typename Cmp>
+Out mergeRuns(InA a, InA aEnd, InB b, InB bEnd, Out out, Cmp comp) {
+    // Số phần tử chỉ được tính khi có đo: tránh làm thay đổi cách cấp phát thanh ghi của vòng trộn
+    if constexpr (isInstrumented<Cmp>)
+        comp.note(SortEvent::Move, static_cast<size_t>((aEnd - a) + (bEnd - b)));
+    if (a != aEnd && b != bEnd && !comp(*b, *std::prev(aEnd))) {
+        out = std::move(a, aEnd, out);
+        return std::move(b, bEnd, out);
+    }
+    while (a != aEnd && b != bEnd) {
+        if (comp(*b, *a))
+            *out++ = std::move(*b++);
+        else
+            *out++ = std::move(*a++);
+    }
+    out = std::move(a, aEnd, out);
+    return std::move(b, bEnd, out);
+}
+
+// Trộn [a, aEnd) và [b, bEnd) vào out bằng kernel bitonic merge SIMD khi kiểu, bộ so sánh (std::less / std::greater) và
+// CPU được hỗ trợ: phần lớn đi qua thanh ghi AVX2, phần đuôi trộn vô hướng. Các trường hợp khác dùng mergeRuns.
+// Không ổn định (xem SimdMergeKernel)
+template <typename T, typename Cmp>
+T* simdMergeRuns(const T* a, const T* aEnd, const T* b, const T* bEnd, T* out, Cmp comp) {
+    constexpr size_t block = SimdMergeKernel<T>::block;
+    if constexpr (block != 0) {
+        if (simdMergeBlock<T>(comp) != 0) {
+            alignas(32) T pending[block];
+            const size_t kept = SimdMergeKernel<T>::merge(a, aEnd, b, bEnd, out, pending, std::is_same<Cmp, std::greater<T>>::value);
+            if (kept != 0) {
+                if (std::min(aEnd - a, bEnd - b) < static_cast<std::ptrdiff_t>(block)) {
+                    // Dãy ngắn hơn (dưới một khối) được trộn với pending vào vùng đệm nhỏ, rồi trộn với dãy còn lại
+                    if (bEnd - b < aEnd - a) {
+                        std::swap(a, b);
+                        std::swap(aEnd, bEnd);
+                    }
+                    alignas(32) T merged[2 * block];
+                    T* mergedEnd = sort_engine::mergeRuns(pending, pending + kept, a, aEnd, merged, comp);
+                    return sort_engine::mergeRuns(merged, mergedEnd, b, bEnd, out, comp);
+                }
+                // Kernel dừng sớm vì gặp NaN: trộn 3 nhánh cho tới khi hết pending
+                const T* p = pending;
+                const T* pEnd = pending + kept;
+                while (p != pEnd) {
+                    if (a != aEnd && comp(*a, *p) && (b == bEnd || !comp(*b, *a)))
+                        *out++ = *a++;
+                    else if (b != bEnd && comp(*b, *p))
+                        *out++ = *b++;
+                    else
+                        *out++ = *p++;
+                }
+            }
+        }
+    }
+    return sort_engine::mergeRuns(a, aEnd, b, bEnd, out, comp);
+}
+
+// Trộn ổn định như mergeRuns. Trộn SIMD không ổn định nên, giống stableSimdCapacity, chỉ được dùng cho số nguyên
+// (các phần tử bằng nhau không phân biệt được)
+template <typename InA, typename InB, typename Out, typename Cmp>
+Out mergeStable(InA a, InA aEnd, InB b, InB bEnd, Out out, Cmp comp) {
+    if constexpr (std::is_pointer<InA>::value && std::is_pointer<InB>::value && std::is_pointer<Out>::value &&
+                  std::is_integral<ValueOf<Out>>::value) {
+        using T = ValueOf<Out>;
+        if constexpr (std::is_same<ValueOf<InA>, T>::value && std::is_same<ValueOf<InB>, T>::value)
+            return sort_engine::simdMergeRuns<T>(a, aEnd, b, bEnd, out, comp);
+        else
+            return sort_engine::mergeRuns(a, aEnd, b, bEnd, out, comp);
+    } else {
+        return sort_engine::mergeRuns(a, aEnd, b, bEnd, out, comp);
+    }
+}
+
+// Một lượt trộn từng cặp run từ src sang dst (cùng vị trí tương đối), cập nhật lại runs
+template <typename Src, typename Dst, typename Runs, typename Cmp>
+void mergePass(Src src, Dst dst, Runs& runs, Cmp comp) {
+    const size_t n = runs.back();
+    size_t count = 0;
+    size_t k = 0;
+    for (; k + 2 < runs.size(); k += 2) {
+        sort_engine::mergeStable(src + runs[k], src + runs[k + 1], src + runs[k + 1], src + runs[k + 2], dst + runs[k], comp);
+        runs[count++] = runs[k];
+    }
+    if (k + 2 == runs.size()) { // số run lẻ: chuyển nguyên run cuối sang
+        std::move(src + runs[k], src + runs[k + 1], dst + runs[k]);
+        sort_engine::note(comp, SortEvent::Move, runs[k + 1] - runs[k]);
+        runs[count++] = runs[k];
+    }
+    runs[count++] = n;
+    runs.resize(count);
+}
+
+// Merge sort ổn định kiểu TimSort bottom-up trên [first, last): trộn qua lại (ping-pong) giữa dãy và vùng đệm.
+// buffer() trả về iterator tới vùng đệm tối thiểu last - first phần tử, chỉ được gọi khi thật sự cần trộn.
+// Danh sách biên của các run được cấp phát từ resource.
+template <typename It, typename BufferFn, typename Cmp>
+void mergeSort(It first, It last, BufferFn&& buffer, Cmp comp,
+               std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+    if (last - first < 2)
+        return;
+    std::pmr::vector<size_t> runs(resource);
+    sort_engine::collectRuns(first, last, runs, comp);
+    if (runs.size() <= 2)
+        return;
+
+    auto scratch = buffer();
+    bool inBuffer = false;
+    while (runs.size() > 2) {
+        if (inBuffer)
+            sort_engine::mergePass(scratch, first, runs, comp);
+        else
+            sort_engine::mergePass(first, scratch, runs, comp);
+        inBuffer = !inBuffer;
+    }
+    if (inBuffer) {
+        std::move(scratch, scratch + (last - first), first);
+        sort_engine::note(comp, SortEvent::Move, static_cast<size_t>(last - first));
+    }
+}
+
+// ----------------------------------------------------------------- Trộn tại chỗ -----------------------------------------------------------------
+
+// upper_bound trên [first, last) nhưng dò theo bước lũy thừa 2 từ cuối về (galloping): O(log d) phép so sánh
+// với d là khoảng cách từ kết quả tới last, rất rẻ khi value thuộc về gần cuối đoạn
+template <typename It, typename T, typename Cmp>
+It gallopUpperFromBack(It first, It last, const T& value, Cmp comp) {
+    DifferenceOf<It> step = 1;
+    It lo = first;
+    It hi = last;
+    while (hi - first > step) {
+        It probe = hi - step;
+        if (!comp(value, *probe)) {
+            lo = probe + 1;
+            break;
+        }
+        hi = probe;
+        step *= 2;
+    }
+    return std::upper_bound(lo, hi, value, comp);
+}
+
+// Trộn [first, middle) với đoạn phải đã được chuyển vào buffer[0, count), ghi từ cuối về last.
+// Khi bằng nhau phần tử bên trái đứng trước. Nếu đoạn phải nhỏ hơn nhiều so với đoạn trái, mỗi phần tử của nó
+// tìm vị trí bằng galloping rồi cả khối phần tử trái phía sau được dời một lần, thay vì so sánh từng phần tử.
+template <typename It, typename Buf, typename Cmp>
+void mergeBackward(It first, It middle, It last, Buf buffer, DifferenceOf<It> count, Cmp comp) {
+    It left = middle;
+    It out = last;
+    Buf right = buffer + count;
+    const bool gallop = count * 8 < middle - first;
+    while (right != buffer) {
+        if (gallop) {
+            It pos = sort_engine::gallopUpperFromBack(first, left, *(right - 1), comp);
+            out = std::move_backward(pos, left, out);
+            sort_engine::note(comp, SortEvent::Move, static_cast<size_t>(left - pos));
+            left = pos;
+            *--out = std::move(*--right);
+        } else if (left != first && comp(*(right - 1), *(left - 1))) {
+            *--out = std::move(*--left);
+            sort_engine::note(comp, SortEvent::Move);
+        } else {
+            *--out = std::move(*--right);
+        }
+    }
+    sort_engine::note(comp, SortEvent::Move, static_cast<size_t>(count));
+}
+
+// Trộn ổn định [first, middle) và [middle, last) chỉ dùng buffer cỡ bufferSize: nếu một trong hai đoạn vừa buffer thì
+// trộn trực tiếp, ngược lại chia đôi bằng tìm kiếm nhị phân + rotate rồi đệ quy (như std::inplace_merge)
+template <typename It, typename Buf, typename Cmp>
+void mergeAdaptive(It first, It middle, It last, Buf buffer, DifferenceOf<It> bufferSize, Cmp comp) {
+    const DifferenceOf<It> len1 = middle - first;
+    const DifferenceOf<It> len2 = last - middle;
+    if (len1 == 0 || len2 == 0 || !comp(*middle, *(middle - 1)))
+        return;
+    if (len2 <= bufferSize) {
+        std::move(middle, last, buffer);
+        sort_engine::note(comp, SortEvent::Move, static_cast<size_t>(len2));
+        sort_engine::mergeBackward(first, middle, last, buffer, len2, comp);
+    } else if (len1 <= bufferSize) {
+        std::move(first, middle, buffer);
+        sort_engine::note(comp, SortEvent::Move, static_cast<size_t>(len1));
+        sort_engine::mergeRuns(buffer, buffer + len1, middle, last, first, comp);
+    } else {
+        It cut1, cut2;
+        if (len1 > len2) {
+            cut1 = first + len1 / 2;
+            cut2 = std::lower_bound(middle, last, *cut1, comp);
+        } else {
+            cut2 = middle + len2 / 2;
+            cut1 = std::upper_bound(first, middle, *cut2, comp);
+        }
+        It newMiddle = std::rotate(cut1, middle, cut2);
+        sort_engine::note(comp, SortEvent::Move, static_cast<size_t>(cut2 - cut1));
+        sort_engine::note(comp, SortEvent::Enter);
+        sort_engine::mergeAdaptive(first, cut1, newMiddle, buffer, bufferSize, comp);
+        sort_engine::mergeAdaptive(newMiddle, cut2, last, buffer, bufferSize, comp);
+        sort_engine::note(comp, SortEvent::Leave);
+    }
+}
+
+} // namespace sort_engine
+
+#endif
@@ -0,0 +1,212 @@
+#ifndef _C_PLUS_PLUS_STRING_SORT_ALGORIHMS_
+#define _C_PLUS_PLUS_STRING_SORT_ALGORIHMS_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "C_Plus_Plus_Data_Structure_Algorihms.h"
+
+// ----------------------------------------------------------------- String Sort -----------------------------------------------------------------
+// Sắp xếp chuỗi theo thứ tự từ điển của byte (như std::string::compare / strcmp) bằng multikey quicksort:
+// mỗi chuỗi được đại diện bởi một khóa nhỏ (con trỏ, độ dài, 8 byte tiền tố đã nạp sẵn) và quá trình phân hoạch chỉ
+// so sánh 8 byte tiền tố như một số nguyên 64 bit. Các chuỗi bằng nhau ở 8 byte hiện tại mới được nạp 8 byte tiếp theo,
+// nên phần tiền tố chung không bị quét lại ở mỗi phép so sánh như khi dùng QuickSort<std::string>.
+// Nội dung chuỗi không bao giờ bị sao chép: các khóa được sắp xếp, rồi các phần tử của mảng được move về vị trí cuối
+// cùng qua một vùng đệm (với std::string chỉ con trỏ được chuyển, vùng nhớ của chuỗi giữ nguyên).
+// Hỗ trợ std::string, std::string_view, const char* và char* (C string khác nullptr, so sánh theo nội dung chứ không
+// theo địa chỉ). Bộ so sánh khác SortDirection / std::less / std::greater dùng introsort tổng quát của sort_engine.
+
+namespace string_sort_detail {
+
+// Đọc một phần tử thành dãy byte
+template <typename T>
+struct StringAccess {
+    static constexpr bool supported = false;
+};
+
+template <>
+struct StringAccess<std::string> {
+    static constexpr bool supported = true;
+    static std::string_view view(const std::string& s) { return s; }
+};
+
+template <>
+struct StringAccess<std::string_view> {
+    static constexpr bool supported = true;
+    static std::string_view view(std::string_view s) { return s; }
+};
+
+template <>
+struct StringAccess<const char*> {
+    static constexpr bool supported = true;
+    static std::string_view view(const char* s) { return s; }
+};
+
+template <>
+struct StringAccess<char*> {
+    static constexpr bool supported = true;
+    static std::string_view view(const char* s) { return s; }
+};
+
+// Khóa của một chuỗi: vị trí ban đầu trong mảng và 8 byte bắt đầu từ độ sâu đang xét
+struct StringKey {
+    const unsigned char* text;
+    size_t length;
+    uint64_t cache;   // big-endian để so sánh số nguyên trùng với so sánh byte, lấp 0 sau khi hết chuỗi
+    size_t index;
+};
+
+// Dưới ngưỡng này đoạn được sắp xếp bằng insertion sort trên khóa
+constexpr size_t insertionLimit = 16;
+
+inline uint64_t loadPrefix(const unsigned char* text, size_t length, size_t depth) {
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (depth + 8 <= length) {
+        uint64_t word;
+        std::memcpy(&word, text + depth, 8);
+        return __builtin_bswap64(word);
+    }
+#endif
+    uint64_t key = 0;
+    for (size_t i = depth; i < length && i < depth + 8; ++i)
+        key |= static_cast<uint64_t>(text[i]) << (8 * (7 - (i - depth)));
+    return key;
+}
+
+inline void loadPrefixes(StringKey* keys, size_t n, size_t depth) {
+    for (size_t i = 0; i < n; ++i)
+        keys[i].cache = loadPrefix(keys[i].text, keys[i].length, depth);
+}
+
+// a đứng trước b khi hai chuỗi bằng nhau ở depth byte đầu và cache chứa byte [depth, depth + 8).
+// Cache bằng nhau và một chuỗi đã kết thúc trong 8 byte này thì phần còn lại của chuỗi kia toàn byte 0: chuỗi ngắn hơn đứng trước
+inline bool lessFrom(const StringKey& a, const StringKey& b, size_t depth) {
+    if (a.cache != b.cache)
+        return a.cache < b.cache;
+    const size_t next = depth + 8;
+    if (a.length <= next || b.length <= next)
+        return a.length < b.length;
+    const int order = std::memcmp(a.text + next, b.text + next, std::min(a.length, b.length) - next);
+    return order != 0 ? order < 0 : a.length < b.length;
+}
+
+inline void insertionSort(StringKey* keys, size_t n, size_t depth) {
+    for (size_t i = 1; i < n; ++i) {
+        StringKey key = keys[i];
+        size_t j = i;
+        for (; j > 0 && lessFrom(key, keys[j - 1], depth); --j)
+            keys[j] = keys[j - 1];
+        keys[j] = key;
+    }
+}
+
+inline uint64_t median3(uint64_t a, uint64_t b, uint64_t c) {
+    return std::max(std::min(a, b), std::min(std::max(a, b), c));
+}
+
+// Multikey quicksort trên keys[0, n), các chuỗi bằng nhau ở depth byte đầu và cache đã được nạp cho depth.
+// Phân hoạch 3 nhánh theo cache: nhóm nhỏ hơn và lớn hơn giữ nguyên độ sâu, nhóm bằng đi tiếp 8 byte.
+// Chỉ đệ quy trên hai nhóm nhỏ hơn và lặp trên nhóm lớn nhất, nên độ sâu ngăn xếp là O(log n).
+inline void multikeyQuickSort(StringKey* keys, size_t n, size_t depth) {
+    while (n > insertionLimit) {
+        const uint64_t pivot = median3(keys[0].cache, keys[n / 2].cache, keys[n - 1].cache);
+        // Hai lần phân hoạch kiểu Hoare (chỉ đổi chỗ các phần tử sai phía) thay cho một lần phân hoạch 3 nhánh kiểu Dijkstra
+        StringKey* middle = std::partition(keys, keys + n, [pivot](const StringKey& key) { return key.cache < pivot; });
+        StringKey* upper = std::partition(middle, keys + n, [pivot](const StringKey& key) { return key.cache == pivot; });
+        const size_t less = static_cast<size_t>(middle - keys), greater = static_cast<size_t>(upper - keys);
+
+        // Trong nhóm bằng pivot, các chuỗi kết thúc trong 8 byte này chỉ còn khác nhau ở độ dài và đứng trước các chuỗi dài hơn
+        StringKey* equal = keys + less;
+        StringKey* longer = std::partition(equal, keys + greater, [&](const StringKey& key) { return key.length <= depth + 8; });
+        std::sort(equal, longer, [](const StringKey& a, const StringKey& b) { return a.length < b.length; });
+        const size_t longerCount = static_cast<size_t>(keys + greater - longer);
+        loadPrefixes(longer, longerCount, depth + 8);
+
+        struct Part {
+            StringKey* first;
+            size_t n;
+            size_t depth;
+        };
+        Part parts[3] = {{keys, less, depth}, {longer, longerCount, depth + 8}, {keys + greater, n - greater, depth}};
+        std::sort(parts, parts + 3, [](const Part& a, const Part& b) { return a.n < b.n; });
+        multikeyQuickSort(parts[0].first, parts[0].n, parts[0].depth);
+        multikeyQuickSort(parts[1].first, parts[1].n, parts[1].depth);
+        keys = parts[2].first;
+        n = parts[2].n;
+        depth = parts[2].depth;
+    }
+    insertionSort(keys, n, depth);
+}
+
+// Đưa data[keys[i].index] về vị trí i. Gom (gather) vào vùng đệm rồi chép lại tuần tự thay vì đi theo chu trình của
+// hoán vị: các lần đọc ngẫu nhiên độc lập với nhau nên CPU chồng được các cache miss, còn chu trình thì nối tiếp từng bước
+template <typename T>
+void applyOrder(T* data, const StringKey* keys, size_t n, std::pmr::memory_resource* resource) {
+    std::pmr::vector<T> sorted(resource);
+    sorted.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+        sorted.push_back(std::move(data[keys[i].index]));
+    std::move(sorted.begin(), sorted.end(), data);
+}
+
+template <typename T>
+void sortStrings(T* data, size_t n, bool descending, std::pmr::memory_resource* resource) {
+    if (n < 2)
+        return;
+    std::pmr::vector<StringKey> keys(n, resource);
+    for (size_t i = 0; i < n; ++i) {
+        const std::string_view text = StringAccess<T>::view(data[i]);
+        keys[i].text = reinterpret_cast<const unsigned char*>(text.data());
+        keys[i].length = text.size();
+        keys[i].index = i;
+    }
+    loadPrefixes(keys.data(), n, 0);
+    multikeyQuickSort(keys.data(), n, 0);
+    if (descending)
+        std::reverse(keys.begin(), keys.end());
+    applyOrder(data, keys.data(), n, resource);
+}
+
+} // namespace string_sort_detail
+
+template <typename T, typename Compare = DirectionOrder<T>>
+class StringSort : public BasicSort<T, Compare> {
+    static_assert(string_sort_detail::StringAccess<T>::supported,
+                  "StringSort: T must be std::string, std::string_view, const char* or char*");
+
+public:
+    using BasicSort<T, Compare>::BasicSort;
+
+    // resource: nguồn cấp phát mảng khóa và vùng đệm, VD một SortArena dùng chung cho nhiều lần sắp xếp
+    StringSort(T* arr, size_t sz, Compare cmp, std::pmr::memory_resource* resource)
+        : BasicSort<T, Compare>(arr, sz, cmp), resource(resource) {}
+
+    StringSort(std::vector<T>& vec, Compare cmp, std::pmr::memory_resource* resource)
+        : BasicSort<T, Compare>(vec, cmp), resource(resource) {}
+
+    void sort() override {
+        this->withComparator([this](auto comp) { sortWith(comp); });
+    }
+
+private:
+    template <typename Cmp>
+    void sortWith(Cmp comp) {
+        if constexpr (std::is_same<Cmp, std::less<T>>::value)
+            string_sort_detail::sortStrings(this->data, this->size, false, resource);
+        else if constexpr (std::is_same<Cmp, std::greater<T>>::value)
+            string_sort_detail::sortStrings(this->data, this->size, true, resource);
+        else
+            sort_engine::quickSort(this->data, this->data + this->size, comp);
+    }
+
+    std::pmr::memory_resource* resource = std::pmr::get_default_resource();
+};
+
+#endif
@@ -0,0 +1,271 @@
+#ifndef _C_PLUS_PLUS_THREAD_POOL_ALGORIHMS_
+#define _C_PLUS_PLUS_THREAD_POOL_ALGORIHMS_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Thread pool kiểu work-stealing: mỗi luồng có một hàng đợi riêng,
+// lấy việc ở cuối hàng đợi của mình (LIFO) và "ăn cắp" việc ở đầu hàng đợi của luồng khác (FIFO).
+// Luồng gọi wait()/helpUntil() cũng tham gia xử lí công việc (slot 0), nên pool N luồng chỉ tạo N - 1 worker.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(size_t threadCount = 0) {
+        if (threadCount == 0)
+            threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+        for (size_t i = 0; i < threadCount; ++i)
+            queues.push_back(std::make_unique<WorkQueue>());
+        for (size_t i = 1; i < threadCount; ++i)
+            workers.emplace_back([this, i] { workerLoop(i); });
+    }
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            stopping = true;
+        }
+        sleepCv.notify_all();
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Nhóm công việc trên pool: wait() chỉ chờ và ném lại ngoại lệ đầu tiên của các việc trong nhóm, nên nhiều thuật toán
+    // dùng chung một pool (VD sharedWorkStealingPool) không chờ lẫn nhau hay nhận lỗi của nhau. Việc trong nhóm được
+    // submit thêm việc vào chính nhóm đó.
+    class TaskGroup {
+    public:
+        explicit TaskGroup(WorkStealingPool& pool) : owner(pool) {}
+
+        // Các việc còn chạy tham chiếu tới nhóm, nên phải chờ chúng xong trước khi hủy
+        ~TaskGroup() {
+            owner.helpUntil([this] { return remaining.load(std::memory_order_acquire) == 0; });
+        }
+
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        WorkStealingPool& pool() const { return owner; }
+
+        template <typename Task>
+        void submit(Task task) {
+            remaining.fetch_add(1, std::memory_order_relaxed);
+            owner.submit([this, task]() mutable {
+                try {
+                    task();
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(failureMutex);
+                    if (!failure)
+                        failure = std::current_exception();
+                }
+                // Thao tác cuối cùng chạm tới nhóm: sau đó luồng chờ có thể hủy nhóm
+                remaining.fetch_sub(1, std::memory_order_release);
+            });
+        }
+
+        void wait() {
+            owner.helpUntil([this] { return remaining.load(std::memory_order_acquire) == 0; });
+            std::exception_ptr error;
+            {
+                std::lock_guard<std::mutex> lock(failureMutex);
+                std::swap(error, failure);
+            }
+            if (error)
+                std::rethrow_exception(error);
+        }
+
+    private:
+        WorkStealingPool& owner;
+        std::atomic<size_t> remaining{0};
+        std::mutex failureMutex;
+        std::exception_ptr failure;
+    };
+
+    size_t size() const { return queues.size(); }
+
+    // Chỉ số slot [0, size()) của luồng đang chạy trong pool, 0 nếu gọi từ ngoài pool.
+    // Dùng để mỗi luồng giữ vùng nhớ tạm riêng mà không cần khóa.
+    size_t workerIndex() const { return currentIndex(); }
+
+    // Đẩy công việc vào hàng đợi của luồng hiện tại (hoặc slot 0 nếu gọi từ ngoài pool)
+    void submit(std::function<void()> task) {
+        // Tăng bộ đếm trước khi đẩy việc để queued không bao giờ nhỏ hơn số việc thực sự trong hàng đợi
+        pending.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            queued.fetch_add(1, std::memory_order_release);
+        }
+        WorkQueue& queue = *queues[currentIndex()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        }
+        sleepCv.notify_one();
+    }
+
+    // Chạy các công việc đang chờ cho đến khi done() trả về true (dùng để chờ một nhóm việc con)
+    template <typename Done>
+    void helpUntil(Done done) {
+        WorkerSlot& slot = currentSlot();
+        WorkerSlot saved = slot;
+        if (slot.pool != this)
+            slot = WorkerSlot{this, 0};
+
+        while (!done()) {
+            if (!runOne(slot.index))
+                std::this_thread::yield();
+        }
+        slot = saved;
+    }
+
+    // Chạy body(0..count-1) song song rồi chờ chúng hoàn thành, luồng gọi tham gia xử lí trong lúc chờ.
+    // Có thể gọi lồng bên trong một công việc khác của pool. Ngoại lệ đầu tiên của bất kì body(b) nào được ném lại ở đây
+    // (không đi vào lỗi chung của pool mà wait() ném ra).
+    template <typename Body>
+    void parallelFor(size_t count, Body body) {
+        if (count == 0)
+            return;
+        std::atomic<size_t> remaining(count);
+        std::mutex failureMutex;
+        std::exception_ptr failure;
+        // Bắt ngoại lệ ngay trong từng phần việc và giảm bộ đếm kể cả khi body ném ngoại lệ, tránh việc chờ mãi
+        auto run = [&](size_t b) {
+            try {
+                body(b);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(failureMutex);
+                if (!failure)
+                    failure = std::current_exception();
+            }
+            remaining.fetch_sub(1, std::memory_order_release);
+        };
+        for (size_t b = 1; b < count; ++b)
+            submit([&run, b] { run(b); });
+        run(0);
+        // Các công việc con tham chiếu tới biến trên stack, nên phải chờ xong hết rồi mới ném lại ngoại lệ
+        helpUntil([&remaining] { return remaining.load(std::memory_order_acquire) == 0; });
+        if (failure)
+            std::rethrow_exception(failure);
+    }
+
+    // Chờ tất cả công việc đã submit hoàn thành, ném lại ngoại lệ đầu tiên nếu có
+    void wait() {
+        helpUntil([this] { return pending.load(std::memory_order_acquire) == 0; });
+        std::exception_ptr failure;
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            std::swap(failure, error);
+        }
+        if (failure)
+            std::rethrow_exception(failure);
+    }
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    struct WorkerSlot {
+        const WorkStealingPool* pool = nullptr;
+        size_t index = 0;
+    };
+
+    static WorkerSlot& currentSlot() {
+        static thread_local WorkerSlot slot;
+        return slot;
+    }
+
+    size_t currentIndex() const {
+        const WorkerSlot& slot = currentSlot();
+        return slot.pool == this ? slot.index : 0;
+    }
+
+    bool popOwn(size_t self, std::function<void()>& task) {
+        WorkQueue& queue = *queues[self];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+            return false;
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(size_t self, std::function<void()>& task) {
+        for (size_t k = 1; k < queues.size(); ++k) {
+            WorkQueue& queue = *queues[(self + k) % queues.size()];
+            std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+            if (!lock.owns_lock() || queue.tasks.empty())
+                continue;
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    bool runOne(size_t self) {
+        std::function<void()> task;
+        if (!popOwn(self, task) && !steal(self, task))
+            return false;
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        try {
+            task();
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error)
+                error = std::current_exception();
+        }
+        pending.fetch_sub(1, std::memory_order_acq_rel);
+        return true;
+    }
+
+    void workerLoop(size_t self) {
+        currentSlot() = WorkerSlot{this, self};
+        for (;;) {
+            if (runOne(self))
+                continue;
+            std::unique_lock<std::mutex> lock(sleepMutex);
+            sleepCv.wait(lock, [this] { return stopping || queued.load(std::memory_order_acquire) > 0; });
+            if (stopping)
+                return;
+        }
+    }
+
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<size_t> pending{0};
+    std::atomic<size_t> queued{0};
+    bool stopping = false;
+    std::mutex sleepMutex;
+    std::condition_variable sleepCv;
+    std::mutex errorMutex;
+    std::exception_ptr error;
+};
+
+// Pool dùng chung trong cả chương trình cho mỗi số luồng (threads = 0 nghĩa là hardware_concurrency()), được tạo ở lần
+// gọi đầu tiên và giữ tới khi chương trình kết thúc. Các lớp sắp xếp song song dùng nó khi không được truyền pool riêng,
+// nên mỗi lần sort() không phải tạo và join threads - 1 luồng.
+inline WorkStealingPool& sharedWorkStealingPool(size_t threads = 0) {
+    if (threads == 0)
+        threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    static std::mutex mutex;
+    static std::map<size_t, std::unique_ptr<WorkStealingPool>> pools;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_ptr<WorkStealingPool>& pool = pools[threads];
+    if (!pool)
+        pool = std::make_unique<WorkStealingPool>(threads);
+    return *pool;
+}
+
+#endif